@@ -0,0 +1,1627 @@
+#pragma once
+
+#include <future>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <limits>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <exception>
+#include "native_thread.h"
+#include "workload_capture.h"
+#include "thread_pool_policies.h"
+
+#define M_ENABLED m_bEnabled.load( std::memory_order_relaxed )
+
+
+//============================================================
+//	\class	BasicThreadPool
+//
+//	\author	KeyC0de
+//	\date	25/9/2019 3:55
+//
+//	\brief	A class which encapsulates a Queue of Tasks & a Pool of threads
+//				and dispatches work on demand - ie. upon an incoming Task - callable object -
+//				a thread is dispatched to execute it
+//			Tasks submitted with a key are routed to a preferred worker so that all
+//				tasks of the same key run on the same thread and find its data hot in cache
+//			A lazy pool spawns workers only as tasks back up, up to the given thread count
+//			The number of active workers can be changed with resize or setThreadCount, by hand
+//				or by the optional hill-climbing controller
+//			An optional watchdog reports tasks that run too long and a queue that stopped draining
+//			Recording mode logs every task's timing to a file for replayWorkload
+//			Untagged submissions may be spread over per-producer shards so that many producers
+//				don't serialize on the pool's lock - see setSubmissionShards
+//			Workers may take a share of the backlog - up to a maximum batch - per lock acquisition
+//			Tasks may be tagged with a tenant; tenants and untagged tasks get their own queues
+//				served by weighted deficit round robin, so one tenant's flood can't starve the others
+//			The shared queue, the way idle workers wait and the task storage are
+//				compile time policies - see thread_pool_policies.h
+//			stop( true ) runs every queued task before the workers exit
+//			Singleton per instantiation, move only class
+//=============================================================
+template<template<typename> class QueuePolicy, typename IdlePolicy, typename TaskPolicy>
+class BasicThreadPool final
+{
+	using Task = typename TaskPolicy::Task;
+
+	struct Worker
+	{
+		NativeThread thread;
+		std::deque<Task> tasks;			// keyed tasks which prefer this worker
+		Task handoff;					// handed to this worker alone by enqueueOnIdleWorkers
+		bool bHandoff = false;			// guarded by m_mu, like handoff
+		std::condition_variable cond;
+		bool bIdle = false;				// parked in m_idle, guarded by m_mu
+		bool bRunning = false;			// claimed by startWorker and not yet retired, guarded by m_mu
+		std::atomic<bool> bSignaled{false};	// raised under m_mu to end a park, see IdlePolicy
+		std::atomic<std::size_t> nCompleted{0};
+		std::atomic<std::size_t> nBatched{0};	// tasks taken along & not yet started
+		std::atomic<long long> taskStart{0};	// steady_clock ticks, 0 while idle or not watched
+		std::atomic<const char*> taskLabel{nullptr};
+	};
+
+	// a tenant's queue & statistics, guarded by m_mu
+	struct Tenant
+	{
+		std::deque<std::pair<Task, std::chrono::steady_clock::time_point>> tasks;
+		std::size_t weight;
+		std::size_t nExecuted = 0;
+		std::chrono::steady_clock::duration totalWait{0};
+		std::chrono::steady_clock::duration maxWait{0};
+	};
+
+	// a slice of the untagged queue owned by the producers that hash to it
+	struct alignas( 64 ) Shard
+	{
+		std::mutex mu;
+		QueuePolicy<Task> tasks;
+		std::atomic<std::size_t> nTasks{0};	// written under mu, read without it
+	};
+
+	// a background thread woken periodically until stopped
+	struct Monitor
+	{
+		std::thread thread;
+		std::mutex mu;
+		std::condition_variable cond;
+		bool bStop = false;
+	};
+
+	std::atomic<bool> m_bEnabled;
+	bool m_bDraining;					// stop( true ) in progress, guarded by m_mu
+	std::vector<std::unique_ptr<Worker>> m_workers;
+	std::vector<std::size_t> m_idle;	// indices of parked workers, most recent last
+	QueuePolicy<Task> m_tasks;			// untagged tasks
+	std::vector<std::unique_ptr<Tenant>> m_tenants;	// tenant id - 1
+	std::size_t m_untaggedWeight;
+	std::size_t m_drrSlot;				// 0 - m_tasks, otherwise tenant id, being served
+	std::size_t m_drrQuantum;			// tasks m_drrSlot may still take this round
+	std::unique_ptr<Shard[]> m_shards;
+	std::atomic<std::size_t> m_nShards;		// shards producers submit to, 0 - sharding off
+	std::atomic<std::size_t> m_nShardsUsed;	// shards workers drain, never shrinks
+	std::size_t m_shardCursor;				// next shard to drain, guarded by m_mu
+	bool m_bShardTurn;						// the shards go before m_tasks on the next untagged pop, guarded by m_mu
+	std::atomic<std::size_t> m_nIdle;		// size of m_idle, raised before a worker's last look at the shards
+	std::mutex m_mu;
+	std::size_t m_stealThreshold;
+	std::size_t m_maxBatch;				// tasks a worker takes per lock acquisition
+	bool m_bLazy;
+	std::size_t m_stackSize;				// 0 - platform default
+	std::atomic<std::size_t> m_nStarted;	// written under m_mu, read by sharded producers
+	std::atomic<std::size_t> m_nTarget;		// workers [0, m_nTarget) may run, written under m_mu
+	std::size_t m_nStarting;				// started workers yet to reach threadMain, guarded by m_mu
+	std::size_t m_nWoken;					// woken workers yet to look for a task, guarded by m_mu
+	std::vector<std::size_t> m_spawns;		// slots claimed by startWorker awaiting a thread, guarded by m_mu
+	std::atomic<bool> m_bSpawnPending;		// m_spawns is not empty
+	std::mutex m_spawnMu;					// guards the workers' thread handles, taken before m_mu
+	Monitor m_controller;
+	Monitor m_watchdog;
+	std::atomic<bool> m_bWatched;			// workers stamp task start times for the watchdog
+	std::atomic<std::size_t> m_nLocalHits;
+	std::atomic<std::size_t> m_nSteals;
+	std::atomic<bool> m_bRecording;
+	std::shared_ptr<WorkloadRecorder> m_recorder;	// accessed through std::atomic_load/store
+
+	// identify the pool & slot the calling thread works for
+	struct CurrentWorker
+	{
+		const BasicThreadPool* pPool = nullptr;
+		std::size_t index = std::numeric_limits<std::size_t>::max();
+	};
+
+	// a function local thread_local - static thread_local data members of an
+	//	explicitly instantiated template don't link reliably across translation units
+	static CurrentWorker& currentWorker() noexcept
+	{
+		static thread_local CurrentWorker current;
+		return current;
+	}
+private:
+	explicit BasicThreadPool( std::size_t nthreads,
+		bool bStart = true,
+		bool bLazy = false,
+		std::size_t stackSize = 0 )
+		:
+		m_bEnabled{bStart},
+		m_bDraining{false},
+		m_untaggedWeight{1},
+		m_drrSlot{0},
+		m_drrQuantum{0},
+		m_shards{std::make_unique<Shard[]>( maxShards )},
+		m_nShards{0},
+		m_nShardsUsed{0},
+		m_shardCursor{0},
+		m_bShardTurn{false},
+		m_nIdle{0},
+		m_stealThreshold{4},
+		m_maxBatch{1},
+		m_bLazy{bLazy},
+		m_stackSize{stackSize},
+		m_nStarted{0},
+		m_nTarget{nthreads},
+		m_nStarting{0},
+		m_nWoken{0},
+		m_bSpawnPending{false},
+		m_bWatched{false},
+		m_nLocalHits{0},
+		m_nSteals{0},
+		m_bRecording{false}
+	{
+		m_workers.reserve( nthreads );
+		for ( std::size_t wi = 0; wi < nthreads; ++wi )
+		{
+			m_workers.emplace_back( std::make_unique<Worker>() );
+		}
+		m_idle.reserve( nthreads );
+		if ( bStart )
+		{
+			run();
+		}
+	}
+public:
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+	static constexpr std::size_t maxShards = 64;
+
+	using TenantId = std::size_t;
+	// the tenant of tasks enqueued without one
+	static constexpr TenantId untagged = 0;
+
+	struct TenantStats
+	{
+		std::size_t nQueued;
+		std::size_t nExecuted;		// tasks handed to a worker so far
+		std::chrono::nanoseconds meanWait;
+		std::chrono::nanoseconds maxWait;
+	};
+
+	struct ControllerOptions
+	{
+		std::size_t minThreads = 1;
+		std::chrono::milliseconds sampleInterval{100};
+		std::chrono::milliseconds idleTimeout{5000};	// retire workers idle for this long
+		double threshold = 0.05;	// relative throughput change regarded as noise
+	};
+
+	struct StallReport
+	{
+		enum class Kind
+		{
+			LongTask,		// a task has been running on workerIndex for duration
+			QueueStalled	// queued tasks have not been drained for duration
+		};
+		Kind kind;
+		std::size_t workerIndex;	// npos for QueueStalled
+		const char* label;			// label given to enqueueLabeled or nullptr
+		std::chrono::milliseconds duration;
+		std::size_t nQueued;
+	};
+
+	struct WatchdogOptions
+	{
+		std::chrono::milliseconds threshold{1000};
+		std::chrono::milliseconds checkInterval{100};
+		std::function<void( const StallReport& )> onStall;	// empty - print to std::cerr
+	};
+
+	~BasicThreadPool() noexcept
+	{
+		stop();
+	}
+
+	BasicThreadPool( BasicThreadPool const& ) = delete;
+	BasicThreadPool& operator=( const BasicThreadPool& rhs ) = delete;
+
+	BasicThreadPool( BasicThreadPool&& rhs ) noexcept
+		:
+		m_bEnabled{std::move( rhs.m_bEnabled.load( std::memory_order_relaxed ) )},
+		m_bDraining{false},
+		m_workers{std::move( rhs.m_workers )},
+		m_idle{std::move( rhs.m_idle )},
+		m_tasks{std::move( rhs.m_tasks )},
+		m_tenants{std::move( rhs.m_tenants )},
+		m_untaggedWeight{rhs.m_untaggedWeight},
+		m_drrSlot{0},
+		m_drrQuantum{0},
+		m_shards{std::move( rhs.m_shards )},
+		m_nShards{rhs.m_nShards.load( std::memory_order_relaxed )},
+		m_nShardsUsed{rhs.m_nShardsUsed.load( std::memory_order_relaxed )},
+		m_shardCursor{0},
+		m_bShardTurn{false},
+		m_nIdle{rhs.m_nIdle.load( std::memory_order_relaxed )},
+		m_stealThreshold{rhs.m_stealThreshold},
+		m_maxBatch{rhs.m_maxBatch},
+		m_bLazy{rhs.m_bLazy},
+		m_stackSize{rhs.m_stackSize},
+		m_nStarted{rhs.m_nStarted.load( std::memory_order_relaxed )},
+		m_nTarget{rhs.m_nTarget.load( std::memory_order_relaxed )},
+		m_nStarting{rhs.m_nStarting},
+		m_nWoken{rhs.m_nWoken},
+		m_spawns{std::move( rhs.m_spawns )},
+		m_bSpawnPending{rhs.m_bSpawnPending.load( std::memory_order_relaxed )},
+		m_bWatched{false},
+		m_nLocalHits{rhs.m_nLocalHits.load( std::memory_order_relaxed )},
+		m_nSteals{rhs.m_nSteals.load( std::memory_order_relaxed )},
+		m_bRecording{false}
+	{
+
+	}
+
+	BasicThreadPool& operator=( BasicThreadPool&& rhs ) noexcept
+	{
+		m_bEnabled.store( rhs.m_bEnabled.load( std::memory_order_relaxed ) );
+		std::swap( m_workers, rhs.m_workers );
+		std::swap( m_idle, rhs.m_idle );
+		std::swap( m_tasks, rhs.m_tasks );
+		std::swap( m_tenants, rhs.m_tenants );
+		m_untaggedWeight = rhs.m_untaggedWeight;
+		m_drrSlot = 0;
+		m_drrQuantum = 0;
+		std::swap( m_shards, rhs.m_shards );
+		m_nShards.store( rhs.m_nShards.load( std::memory_order_relaxed ),
+			std::memory_order_relaxed );
+		m_nShardsUsed.store( rhs.m_nShardsUsed.load( std::memory_order_relaxed ),
+			std::memory_order_relaxed );
+		m_shardCursor = 0;
+		m_bShardTurn = false;
+		m_nIdle.store( rhs.m_nIdle.load( std::memory_order_relaxed ),
+			std::memory_order_relaxed );
+		m_stealThreshold = rhs.m_stealThreshold;
+		m_maxBatch = rhs.m_maxBatch;
+		m_bLazy = rhs.m_bLazy;
+		m_stackSize = rhs.m_stackSize;
+		m_nStarted.store( rhs.m_nStarted.load( std::memory_order_relaxed ),
+			std::memory_order_relaxed );
+		m_nTarget.store( rhs.m_nTarget.load( std::memory_order_relaxed ),
+			std::memory_order_relaxed );
+		m_nStarting = rhs.m_nStarting;
+		m_nWoken = rhs.m_nWoken;
+		std::swap( m_spawns, rhs.m_spawns );
+		m_bSpawnPending.store( rhs.m_bSpawnPending.load( std::memory_order_relaxed ),
+			std::memory_order_relaxed );
+		return *this;
+	}
+
+	//===================================================
+	//	\function	getInstance
+	//	\brief  nThreads is the maximum number of workers; a lazy pool starts with none
+	//			stackSize in bytes, 0 for the platform default
+	//			only the arguments of the first call take effect
+	//	\date	25/9/2019 3:55
+	static BasicThreadPool& getInstance( std::size_t nThreads = std::thread::hardware_concurrency(),
+		bool bEnabled = true,
+		bool bLazy = false,
+		std::size_t stackSize = 0 )
+	{
+		static BasicThreadPool instance{nThreads, bEnabled, bLazy, stackSize};
+		return instance;
+	}
+	//===================================================
+	//	\function	start
+	//	\brief  calls run
+	//	\date	25/9/2019 12:20
+	void start()
+	{
+		if ( !M_ENABLED )
+		{
+			m_bEnabled.store( true,
+				std::memory_order_relaxed );
+			run();
+		}
+	}
+	//===================================================
+	//	\function	stop
+	//	\brief  disables the pool & joins its workers
+	//			bDrain - the workers first run every task still queued, while enqueue is refused
+	//			otherwise queued tasks stay queued until the pool is started again
+	//	\date	25/9/2019 12:20
+	void stop( bool bDrain = false ) noexcept
+	{
+		stopController();
+		stopWatchdog();
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			m_bEnabled.store( false,
+				std::memory_order_relaxed );
+			m_bDraining = bDrain;
+			for ( auto& w : m_workers )
+			{
+				w->bSignaled.store( true,
+					std::memory_order_release );
+				w->cond.notify_all();
+			}
+		}
+		// also reaps workers that exited through disable() or resize
+		//	the handles are taken under m_spawnMu but joined without it, since a retiring worker may still spawn
+		std::vector<NativeThread> threads;
+		{
+			std::lock_guard<std::mutex> lg{m_spawnMu};
+			for ( auto& w : m_workers )
+			{
+				if ( w->thread.joinable() )
+				{
+					threads.emplace_back( std::move( w->thread ) );
+				}
+			}
+		}
+		for ( NativeThread& t : threads )
+		{
+			t.join();
+		}
+		if ( bDrain )
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			m_bDraining = false;
+		}
+	}
+	void enable() noexcept
+	{
+		m_bEnabled.store( true,
+			std::memory_order_relaxed );
+	}
+	void disable() noexcept
+	{
+		m_bEnabled.store( false,
+			std::memory_order_relaxed );
+	}
+	bool isEnabled() const noexcept
+	{
+		return M_ENABLED;
+	}
+	std::size_t workerCount() const noexcept
+	{
+		return m_workers.size();
+	}
+	//===================================================
+	//	\function	workerIndex
+	//	\brief  index in [0, workerCount()) of the calling worker of this pool
+	//			npos if the caller is not one of this pool's workers
+	//	\date	18/10/2026
+	std::size_t workerIndex() const noexcept
+	{
+		const CurrentWorker& current = currentWorker();
+		return current.pPool == this ? current.index : npos;
+	}
+	//===================================================
+	//	\function	prewarm
+	//	\brief  starts up to n workers now so a lazy pool does not pay for spawning later
+	//			throws std::system_error if a thread cannot be created
+	//	\date	18/10/2026
+	void prewarm( std::size_t n = std::numeric_limits<std::size_t>::max() )
+	{
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			if ( !M_ENABLED )
+			{
+				return;
+			}
+			while ( m_nStarted < n && startNextWorker() );
+		}
+		if ( std::exception_ptr error = spawnPending() )
+		{
+			std::rethrow_exception( error );
+		}
+	}
+
+	template<typename Callback, typename... TArgs>
+	decltype( auto ) enqueue( Callback&& f,
+		TArgs&&... args )
+	{
+		if ( M_ENABLED )
+		{
+			Task task;
+			auto fu = makeTask( task,
+				std::forward<Callback>( f ),
+				std::forward<TArgs>( args )... );
+			const std::size_t nShards = m_nShards.load( std::memory_order_acquire );
+			if ( nShards > 0 )
+			{
+				pushShard( std::move( task ),
+					nShards );
+				return fu;
+			}
+			{
+				std::lock_guard<std::mutex> lg{m_mu};
+				m_tasks.push( std::move( task ) );
+				wakeIdleWorker();
+			}
+			// the task is queued - should no thread start it stays with the running workers
+			spawnPending();
+			return fu;
+		}
+		else
+		{
+			throw std::runtime_error{"Cannot enqueue tasks in an inactive Thread Pool!"};
+		}
+	}
+	//===================================================
+	//	\function	enqueueWithKey
+	//	\brief  hashes key to a preferred worker and queues the task there
+	//			other workers only steal it if the preferred worker is overloaded
+	//	\date	18/10/2026
+	template<typename Key, typename Callback, typename... TArgs>
+	decltype( auto ) enqueueWithKey( const Key& key,
+		Callback&& f,
+		TArgs&&... args )
+	{
+		if ( M_ENABLED )
+		{
+			Task task;
+			auto fu = makeTask( task,
+				std::forward<Callback>( f ),
+				std::forward<TArgs>( args )... );
+			{
+				std::lock_guard<std::mutex> lg{m_mu};
+				const std::size_t nTarget = m_nTarget.load( std::memory_order_relaxed );
+				if ( nTarget == 0 )
+				{
+					m_tasks.push( std::move( task ) );
+				}
+				else
+				{
+					pushKeyed( std::hash<Key>{}( key ) % nTarget,
+						std::move( task ) );
+				}
+			}
+			spawnPending();
+			return fu;
+		}
+		else
+		{
+			throw std::runtime_error{"Cannot enqueue tasks in an inactive Thread Pool!"};
+		}
+	}
+	//===================================================
+	//	\function	enqueueLabeled
+	//	\brief  enqueue with a label the watchdog reports should the task stall
+	//			label must outlive the task - typically a string literal
+	//	\date	18/10/2026
+	template<typename Callback, typename... TArgs>
+	decltype( auto ) enqueueLabeled( const char* label,
+		Callback&& f,
+		TArgs&&... args )
+	{
+		return enqueue( [this, label, f = std::forward<Callback>( f )] ( auto&&... a ) mutable -> decltype( auto )
+			{
+				LabelScope scope{*m_workers[currentWorker().index], label};
+				return std::invoke( f, std::forward<decltype( a )>( a )... );
+			},
+			std::forward<TArgs>( args )... );
+	}
+	//===================================================
+	//	\function	enqueueOnIdleWorkers
+	//	\brief  hands f( i ) for i in [0, n) straight to n of the workers parked right now - one each,
+	//				bypassing the queues - and returns their futures; n <= nMax and is 0 if none is parked
+	//			each of these workers runs its task next, even if the pool is resized or stopped
+	//				meanwhile, and takes nothing along with it, so the n tasks are sure to run at once
+	//				on distinct threads & may wait on one another - eg. at a SpinBarrier
+	//	\date	18/10/2026
+	template<typename Callback>
+	auto enqueueOnIdleWorkers( std::size_t nMax,
+		Callback&& f )
+	{
+		if ( !M_ENABLED )
+		{
+			throw std::runtime_error{"Cannot enqueue tasks in an inactive Thread Pool!"};
+		}
+		// built outside the lock for as many workers as may be parked; the surplus is dropped
+		std::vector<Task> tasks( std::min( nMax, m_nIdle.load( std::memory_order_relaxed ) ) );
+		std::vector<std::future<std::invoke_result_t<Callback&, std::size_t>>> futures;
+		futures.reserve( tasks.size() );
+		for ( std::size_t i = 0; i < tasks.size(); ++i )
+		{
+			futures.emplace_back( makeTask( tasks[i],
+				[f, i] () mutable { return f( i ); } ) );
+		}
+		std::size_t nHanded = 0;
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			while ( nHanded < tasks.size() && !m_idle.empty() )
+			{
+				const std::size_t wi = m_idle.back();
+				Worker& w = *m_workers[wi];
+				w.handoff = std::move( tasks[nHanded++] );
+				w.bHandoff = true;
+				wakeWorker( wi );
+			}
+		}
+		futures.erase( futures.begin() + nHanded,
+			futures.end() );
+		return futures;
+	}
+	//===================================================
+	//	\function	addTenant
+	//	\brief  registers a tenant which is served up to weight tasks per round robin turn
+	//			untagged tasks form a tenant of weight 1 of their own
+	//	\date	18/10/2026
+	TenantId addTenant( std::size_t weight = 1 )
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		m_tenants.emplace_back( std::make_unique<Tenant>() );
+		m_tenants.back()->weight = std::max<std::size_t>( weight, 1 );
+		return m_tenants.size();
+	}
+	void setTenantWeight( TenantId tenant,
+		std::size_t weight )
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		weight = std::max<std::size_t>( weight, 1 );
+		if ( tenant == untagged )
+		{
+			m_untaggedWeight = weight;
+		}
+		else
+		{
+			tenantAt( tenant ).weight = weight;
+		}
+	}
+	//===================================================
+	//	\function	enqueueForTenant
+	//	\brief  queues the task on tenant's own queue
+	//	\date	18/10/2026
+	template<typename Callback, typename... TArgs>
+	decltype( auto ) enqueueForTenant( TenantId tenant,
+		Callback&& f,
+		TArgs&&... args )
+	{
+		if ( M_ENABLED )
+		{
+			Task task;
+			auto fu = makeTask( task,
+				std::forward<Callback>( f ),
+				std::forward<TArgs>( args )... );
+			{
+				std::lock_guard<std::mutex> lg{m_mu};
+				if ( tenant == untagged )
+				{
+					m_tasks.push( std::move( task ) );
+				}
+				else
+				{
+					tenantAt( tenant ).tasks.emplace_back( std::move( task ),
+						std::chrono::steady_clock::now() );
+				}
+				wakeIdleWorker();
+			}
+			spawnPending();
+			return fu;
+		}
+		else
+		{
+			throw std::runtime_error{"Cannot enqueue tasks in an inactive Thread Pool!"};
+		}
+	}
+	//===================================================
+	//	\function	tenantStats
+	//	\brief  throughput & queue wait of a tenant since it was added; sample periodically for rates
+	//			untagged tasks carry no enqueue time, so untagged is rejected like an unknown tenant
+	//				with std::out_of_range
+	//	\date	18/10/2026
+	TenantStats tenantStats( TenantId tenant )
+	{
+		using std::chrono::duration_cast;
+		using std::chrono::nanoseconds;
+
+		std::lock_guard<std::mutex> lg{m_mu};
+		const Tenant& t = tenantAt( tenant );
+		return TenantStats{t.tasks.size(),
+			t.nExecuted,
+			duration_cast<nanoseconds>( t.totalWait / std::max<long long>( static_cast<long long>( t.nExecuted ), 1 ) ),
+			duration_cast<nanoseconds>( t.maxWait )};
+	}
+	//===================================================
+	//	\function	setStealThreshold
+	//	\brief  # of tasks a worker's keyed queue must exceed before others may steal from it
+	//	\date	18/10/2026
+	void setStealThreshold( std::size_t n ) noexcept
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		m_stealThreshold = n;
+	}
+	//===================================================
+	//	\function	setSubmissionShards
+	//	\brief  spreads enqueue() over n producer side queues, up to maxShards; 0 turns sharding off
+	//			a producer thread always submits to the same shard and takes the pool's lock
+	//				only to wake an idle worker, so a saturated pool takes submissions from
+	//				many threads without them contending on one lock
+	//			a task then costs a shard lock on either side on top of the pool's, so sharding
+	//				only pays when producers on separate cores actually contend - measure first
+	//			FIFO order then holds per producer, not globally: workers drain the shards round
+	//				robin a task at a time, so a task at position p of its shard is overtaken
+	//				by at most (n - 1) * (p + 1) tasks submitted after it to other shards
+	//			tasks still reaching the pool's own queue - keyed hand backs, untagged tenant
+	//				tasks, submissions after sharding is turned off - take turns with the
+	//				shards pop for pop, so neither side holds the other back by more than a task
+	//			the LIFO queue policy stays LIFO within a shard only
+	//	\date	18/10/2026
+	void setSubmissionShards( std::size_t n ) noexcept
+	{
+		n = std::min( n, maxShards );
+		std::lock_guard<std::mutex> lg{m_mu};
+		if ( n > m_nShardsUsed.load( std::memory_order_relaxed ) )
+		{
+			m_nShardsUsed.store( n,
+				std::memory_order_relaxed );
+		}
+		m_nShards.store( n,
+			std::memory_order_release );
+	}
+	//===================================================
+	//	\function	setMaxBatch
+	//	\brief  most tasks a worker moves out of the queues per lock acquisition; 1 - the default -
+	//				disables batching
+	//			a worker takes at most its fair share - backlog / thread count - so a short
+	//				queue is still spread over all workers
+	//			only for tasks that never wait on other tasks of the pool: a batched task can only
+	//				run on the worker that took it, so a task waiting on one batched behind it
+	//				deadlocks even while other workers are idle
+	//	\date	18/10/2026
+	void setMaxBatch( std::size_t n ) noexcept
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		m_maxBatch = std::max<std::size_t>( n, 1 );
+	}
+	//===================================================
+	//	\function	localityHitRate
+	//	\brief  fraction of keyed tasks that ran on their preferred worker
+	//	\date	18/10/2026
+	double localityHitRate() const noexcept
+	{
+		const std::size_t nHits = m_nLocalHits.load( std::memory_order_relaxed );
+		const std::size_t nSteals = m_nSteals.load( std::memory_order_relaxed );
+		if ( nHits + nSteals == 0 )
+		{
+			return 1.0;
+		}
+		return static_cast<double>( nHits ) / ( nHits + nSteals );
+	}
+	//===================================================
+	//	\function	resize
+	//	\brief  adds # or subtracts -# threads to the ThreadPool
+	//			the thread count is clamped to [1, workerCount()], so a delta computed against a
+	//				count the controller has since lowered can't remove every thread; use stop()
+	//				for that
+	//			retired workers finish their current task and hand their keyed tasks back
+	//	\date	25/9/2019 4:00
+	bool resize( int n )
+	{
+		if ( !isEnabled() )
+		{
+			return false;
+		}
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			const long long nTarget = static_cast<long long>( m_nTarget.load( std::memory_order_relaxed ) ) + n;
+			resizeTo( clampThreadCount( static_cast<std::size_t>( std::max( nTarget, 1ll ) ) ) );
+		}
+		if ( std::exception_ptr error = spawnPending() )
+		{
+			std::rethrow_exception( error );
+		}
+		return true;
+	}
+	//===================================================
+	//	\function	setThreadCount
+	//	\brief  sets the thread count to n, clamped to [1, workerCount()]
+	//			unlike resize the result doesn't depend on the count the controller left behind,
+	//				though the controller may move it again on its next sample
+	//	\date	18/10/2026
+	bool setThreadCount( std::size_t n )
+	{
+		if ( !isEnabled() )
+		{
+			return false;
+		}
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			resizeTo( clampThreadCount( n ) );
+		}
+		if ( std::exception_ptr error = spawnPending() )
+		{
+			std::rethrow_exception( error );
+		}
+		return true;
+	}
+	//===================================================
+	//	\function	threadCount
+	//	\brief  # of workers currently allowed to run
+	//	\date	18/10/2026
+	std::size_t threadCount() const noexcept
+	{
+		return m_nTarget.load( std::memory_order_relaxed );
+	}
+	//===================================================
+	//	\function	startController
+	//	\brief  launches a background thread which samples throughput & queue depth and
+	//				hill-climbs the thread count towards the best throughput
+	//			workers that stay idle for idleTimeout are retired
+	//	\date	18/10/2026
+	void startController()
+	{
+		startController( ControllerOptions{} );
+	}
+	void startController( const ControllerOptions& opts )
+	{
+		stopController();
+		m_controller.bStop = false;
+		m_controller.thread = std::thread{&BasicThreadPool::controllerMain, this, opts};
+	}
+	void stopController() noexcept
+	{
+		stopMonitor( m_controller );
+	}
+	//===================================================
+	//	\function	startWatchdog
+	//	\brief  launches a background thread which reports every task running longer than
+	//				threshold and a queue that has not drained for threshold
+	//			each stall is reported once
+	//	\date	18/10/2026
+	void startWatchdog()
+	{
+		startWatchdog( WatchdogOptions{} );
+	}
+	void startWatchdog( const WatchdogOptions& opts )
+	{
+		stopWatchdog();
+		m_watchdog.bStop = false;
+		m_bWatched.store( true,
+			std::memory_order_relaxed );
+		m_watchdog.thread = std::thread{&BasicThreadPool::watchdogMain, this, opts};
+	}
+	void stopWatchdog() noexcept
+	{
+		stopMonitor( m_watchdog );
+		m_bWatched.store( false,
+			std::memory_order_relaxed );
+	}
+	//===================================================
+	//	\function	startRecording
+	//	\brief  logs enqueue time, queue wait, execution time & submitting thread of every task
+	//				enqueued from now on to a binary capture file - see workload_capture.h
+	//			replaces a recording in progress
+	//	\date	18/10/2026
+	void startRecording( const std::string& path )
+	{
+		std::atomic_store( &m_recorder,
+			std::make_shared<WorkloadRecorder>( path ) );
+		m_bRecording.store( true,
+			std::memory_order_relaxed );
+	}
+	// the capture holds every task whose future was ready by now; tasks still running
+	//	are appended as they finish
+	void stopRecording()
+	{
+		m_bRecording.store( false,
+			std::memory_order_relaxed );
+		std::shared_ptr<WorkloadRecorder> recorder = std::atomic_exchange( &m_recorder,
+			std::shared_ptr<WorkloadRecorder>{} );
+		if ( recorder )
+		{
+			recorder->flush();
+		}
+	}
+private:
+	void run()
+	{
+		if ( m_bLazy )
+		{// workers are spawned by enqueue as the queue backs up
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			while ( startNextWorker() );
+		}
+		if ( std::exception_ptr error = spawnPending() )
+		{
+			std::rethrow_exception( error );
+		}
+	}
+	void threadMain( std::size_t wi )
+	{
+		Worker& self = *m_workers[wi];
+		currentWorker() = CurrentWorker{this, wi};
+		std::vector<Task> batch;
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			--m_nStarting;
+		}
+		// thread sleeps forever until there's a task available
+		while( true )
+		{
+			Task task;
+			{
+				std::unique_lock<std::mutex> ul{m_mu};
+				bool bHandedOff = false;
+				bool bPopped = false;
+				while( !( bHandedOff = takeHandoff( self, task ) )
+					&& isServing( wi )
+					&& !( bPopped = popTask( wi, task ) ) )
+				{
+					if ( !M_ENABLED )
+					{// drained
+						break;
+					}
+					self.bIdle = true;
+					self.bSignaled.store( false,
+						std::memory_order_relaxed );
+					m_idle.push_back( wi );
+					m_nIdle.fetch_add( 1 );
+					if ( isAnyShardOccupied() )
+					{// a producer may have sharded a task before it could see us idle
+						self.bIdle = false;
+						m_idle.pop_back();
+						m_nIdle.fetch_sub( 1 );
+						continue;
+					}
+					IdlePolicy::park( self.cond,
+						ul,
+						self.bSignaled,
+						[this, &self, wi] ()
+						{
+							return !self.bIdle || !M_ENABLED || wi >= m_nTarget.load( std::memory_order_relaxed );
+						} );
+					if ( self.bIdle )
+					{// spurious wakeup or shutdown - nobody popped us off the idle list
+						self.bIdle = false;
+						m_idle.erase( std::find( m_idle.begin(), m_idle.end(), wi ) );
+						m_nIdle.fetch_sub( 1 );
+					}
+					else
+					{
+						--m_nWoken;
+					}
+				}
+
+				if ( !bHandedOff && !bPopped )
+				{
+					retireWorker( wi );
+					break;
+				}
+				if ( !bHandedOff )
+				{// a handed off task may wait on others - nothing must be held up behind it
+					takeBatch( wi,
+						batch );
+				}
+			}
+			runTask( self,
+				task );
+			// tasks taken along are run even if the pool is stopped meanwhile - their futures are waited on
+			for ( Task& next : batch )
+			{
+				self.nBatched.fetch_sub( 1,
+					std::memory_order_relaxed );
+				runTask( self,
+					next );
+			}
+			batch.clear();
+		}
+		// handing back keyed tasks may have claimed a slot for another worker
+		spawnPending();
+	}
+	void runTask( Worker& self,
+		Task& task )
+	{
+		const bool bWatched = m_bWatched.load( std::memory_order_relaxed );
+		if ( bWatched )
+		{
+			self.taskStart.store( std::chrono::steady_clock::now().time_since_epoch().count(),
+				std::memory_order_relaxed );
+		}
+		task();
+		if ( bWatched )
+		{
+			self.taskStart.store( 0,
+				std::memory_order_relaxed );
+		}
+		self.nCompleted.fetch_add( 1,
+			std::memory_order_relaxed );
+	}
+	void controllerMain( ControllerOptions opts )
+	{
+		using Clock = std::chrono::steady_clock;
+
+		auto completedTasks = [this] () noexcept
+		{
+			std::size_t nCompleted = 0;
+			for ( auto& w : m_workers )
+			{
+				nCompleted += w->nCompleted.load( std::memory_order_relaxed );
+			}
+			return nCompleted;
+		};
+
+		const std::size_t nMax = m_workers.size();
+		const std::size_t nMin = std::clamp<std::size_t>( opts.minThreads, 1, nMax );
+		std::size_t lastCompleted = completedTasks();
+		double lastThroughput = -1.0;	// no previous move to judge
+		int direction = 1;
+		Clock::time_point idleSince = Clock::now();
+		std::size_t minIdle = nMax;
+
+		// one step of the controller; claims worker slots which the caller spawns after m_mu is released
+		auto adjust = [&] ( double throughput )
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			if ( !M_ENABLED )
+			{
+				return;
+			}
+			const std::size_t nThreads = m_nTarget.load( std::memory_order_relaxed );
+			const Clock::time_point now = Clock::now();
+
+			// retire the workers that have been idle for the whole timeout
+			if ( m_idle.empty() )
+			{
+				idleSince = now;
+				minIdle = nMax;
+			}
+			else
+			{
+				minIdle = std::min( minIdle, m_idle.size() );
+			}
+			if ( now - idleSince >= opts.idleTimeout )
+			{
+				resizeTo( std::max( nMin, nThreads - std::min( nThreads, minIdle ) ) );
+				idleSince = now;
+				minIdle = nMax;
+				lastThroughput = -1.0;
+				return;
+			}
+
+			if ( queuedTaskCount() == 0 )
+			{// no backlog - more threads can't help
+				lastThroughput = -1.0;
+				return;
+			}
+
+			// hill climbing: keep going while throughput improves, turn back once it doesn't
+			if ( lastThroughput >= 0.0
+				&& throughput <= lastThroughput * ( 1.0 + opts.threshold ) )
+			{
+				direction = -direction;
+			}
+			std::size_t nNext = direction > 0 ? nThreads + 1 : nThreads - 1;
+			if ( nNext < nMin || nNext > nMax )
+			{
+				direction = -direction;
+				nNext = direction > 0 ? nThreads + 1 : nThreads - 1;
+			}
+			if ( nNext >= nMin && nNext <= nMax )
+			{
+				resizeTo( nNext );
+			}
+			lastThroughput = throughput;
+		};
+
+		std::unique_lock<std::mutex> ul{m_controller.mu};
+		while ( !m_controller.cond.wait_for( ul,
+			opts.sampleInterval,
+			[this] () { return m_controller.bStop; } ) )
+		{
+			const std::size_t nCompleted = completedTasks();
+			const double throughput = static_cast<double>( nCompleted - lastCompleted );
+			lastCompleted = nCompleted;
+			adjust( throughput );
+			spawnPending();
+		}
+	}
+	void watchdogMain( WatchdogOptions opts )
+	{
+		using Clock = std::chrono::steady_clock;
+		using std::chrono::duration_cast;
+		using std::chrono::milliseconds;
+
+		if ( !opts.onStall )
+		{
+			opts.onStall = [] ( const StallReport& report )
+			{
+				std::cerr << ( report.kind == StallReport::Kind::LongTask ? "ThreadPool: task " : "ThreadPool: queue stalled " )
+					<< ( report.label != nullptr ? report.label : "" )
+					<< " worker #" << ( report.workerIndex == npos ? -1 : static_cast<long long>( report.workerIndex ) )
+					<< " for " << report.duration.count() << "ms, "
+					<< report.nQueued << " queued\n";
+			};
+		}
+
+		// stalls already reported, so each is reported once
+		std::vector<long long> reportedStart( m_workers.size(), 0 );
+		std::size_t lastCompleted = 0;
+		Clock::time_point lastProgress = Clock::now();
+		bool bQueueReported = false;
+
+		std::unique_lock<std::mutex> ul{m_watchdog.mu};
+		while ( !m_watchdog.cond.wait_for( ul,
+			opts.checkInterval,
+			[this] () { return m_watchdog.bStop; } ) )
+		{
+			const Clock::time_point now = Clock::now();
+			std::size_t nQueued;
+			{
+				std::lock_guard<std::mutex> lg{m_mu};
+				nQueued = queuedTaskCount();
+			}
+
+			std::size_t nCompleted = 0;
+			for ( std::size_t wi = 0; wi < m_workers.size(); ++wi )
+			{
+				Worker& w = *m_workers[wi];
+				nCompleted += w.nCompleted.load( std::memory_order_relaxed );
+				const long long start = w.taskStart.load( std::memory_order_relaxed );
+				if ( start == 0 || start == reportedStart[wi] )
+				{
+					continue;
+				}
+				const auto elapsed = now - Clock::time_point{Clock::duration{start}};
+				if ( elapsed >= opts.threshold )
+				{
+					reportedStart[wi] = start;
+					opts.onStall( StallReport{StallReport::Kind::LongTask,
+						wi,
+						w.taskLabel.load( std::memory_order_relaxed ),
+						duration_cast<milliseconds>( elapsed ),
+						nQueued} );
+				}
+			}
+
+			if ( nCompleted != lastCompleted || nQueued == 0 )
+			{
+				lastCompleted = nCompleted;
+				lastProgress = now;
+				bQueueReported = false;
+			}
+			else if ( !bQueueReported && now - lastProgress >= opts.threshold )
+			{
+				bQueueReported = true;
+				opts.onStall( StallReport{StallReport::Kind::QueueStalled,
+					npos,
+					nullptr,
+					duration_cast<milliseconds>( now - lastProgress ),
+					nQueued} );
+			}
+		}
+	}
+	// the shard's own count is raised under its lock & m_nIdle read after it, both sequentially
+	//	consistent, pairing with a parking worker which raises m_nIdle before reading the counts
+	//	- either the worker sees the task or we see the worker; producers of different shards
+	//	share no written cache line, m_nIdle only changes as workers park & wake
+	void pushShard( Task task,
+		std::size_t nShards )
+	{
+		Shard& shard = m_shards[WorkloadRecorder::threadOrdinal() % nShards];
+		{
+			std::lock_guard<std::mutex> lg{shard.mu};
+			shard.tasks.push( std::move( task ) );
+			shard.nTasks.store( shard.tasks.size() );
+		}
+		if ( m_nIdle.load() > 0
+			|| ( m_bLazy && m_nStarted.load( std::memory_order_relaxed ) < m_nTarget.load( std::memory_order_relaxed ) ) )
+		{
+			{
+				std::lock_guard<std::mutex> lg{m_mu};
+				wakeIdleWorker();
+			}
+			spawnPending();
+		}
+	}
+	// wraps f to time it for the recorder while recording
+	template<typename Callback, typename... TArgs>
+	auto makeTask( Task& task,
+		Callback&& f,
+		TArgs&&... args )
+	{
+		if ( m_bRecording.load( std::memory_order_relaxed ) )
+		{
+			if ( std::shared_ptr<WorkloadRecorder> recorder = std::atomic_load( &m_recorder ) )
+			{
+				return TaskPolicy::make( task,
+					[recorder = std::move( recorder ),
+						enqueued = WorkloadRecorder::Clock::now(),
+						producer = WorkloadRecorder::threadOrdinal(),
+						f = std::forward<Callback>( f )] ( auto&&... a ) mutable -> decltype( auto )
+					{
+						WorkloadRecorder::Scope scope{*recorder, enqueued, producer};
+						return std::invoke( f, std::forward<decltype( a )>( a )... );
+					},
+					std::forward<TArgs>( args )... );
+			}
+		}
+		return TaskPolicy::make( task,
+			std::forward<Callback>( f ),
+			std::forward<TArgs>( args )... );
+	}
+	static void stopMonitor( Monitor& monitor ) noexcept
+	{
+		if ( monitor.thread.joinable() )
+		{
+			{
+				std::lock_guard<std::mutex> lg{monitor.mu};
+				monitor.bStop = true;
+			}
+			monitor.cond.notify_one();
+			monitor.thread.join();
+		}
+	}
+	// all of the following require m_mu to be held
+	static bool takeHandoff( Worker& self,
+		Task& task )
+	{
+		if ( !self.bHandoff )
+		{
+			return false;
+		}
+		task = std::move( self.handoff );
+		self.bHandoff = false;
+		return true;
+	}
+	bool popTask( std::size_t wi, Task& task )
+	{
+		Worker& self = *m_workers[wi];
+		if ( !self.tasks.empty() )
+		{
+			task = std::move( self.tasks.front() );
+			self.tasks.pop_front();
+			m_nLocalHits.fetch_add( 1,
+				std::memory_order_relaxed );
+			return true;
+		}
+
+		if ( popFair( task ) )
+		{
+			return true;
+		}
+
+		// steal from the most overloaded worker, taking its newest task
+		Worker* pVictim = nullptr;
+		for ( auto& w : m_workers )
+		{
+			if ( w->tasks.size() > m_stealThreshold
+				&& ( pVictim == nullptr || w->tasks.size() > pVictim->tasks.size() ) )
+			{
+				pVictim = w.get();
+			}
+		}
+		if ( pVictim != nullptr )
+		{
+			task = std::move( pVictim->tasks.back() );
+			pVictim->tasks.pop_back();
+			m_nSteals.fetch_add( 1,
+				std::memory_order_relaxed );
+			return true;
+		}
+		return false;
+	}
+	// moves this worker's share of the backlog into batch, never stealing
+	void takeBatch( std::size_t wi,
+		std::vector<Task>& batch )
+	{
+		if ( m_maxBatch <= 1 )
+		{
+			return;
+		}
+		Worker& self = *m_workers[wi];
+		const std::size_t nBacklog = self.tasks.size() + sharedTaskCount();
+		const std::size_t nThreads = std::max<std::size_t>( m_nTarget.load( std::memory_order_relaxed ), 1 );
+		const std::size_t nTake = std::min( m_maxBatch - 1, nBacklog / nThreads );
+		Task task;
+		while ( batch.size() < nTake )
+		{
+			if ( !self.tasks.empty() )
+			{
+				task = std::move( self.tasks.front() );
+				self.tasks.pop_front();
+				m_nLocalHits.fetch_add( 1,
+					std::memory_order_relaxed );
+			}
+			else if ( !popFair( task ) )
+			{
+				break;
+			}
+			batch.emplace_back( std::move( task ) );
+		}
+		self.nBatched.store( batch.size(),
+			std::memory_order_relaxed );
+	}
+	// weighted deficit round robin over the untagged queue & the tenants' queues
+	//	with unit task cost: the slot being served takes up to its weight in tasks, then yields
+	bool popFair( Task& task )
+	{
+		if ( m_tenants.empty() )
+		{
+			return popUntagged( task );
+		}
+		const std::size_t nSlots = m_tenants.size() + 1;
+		for ( std::size_t n = 0; n < nSlots; ++n )
+		{
+			const bool bPopped = m_drrSlot == untagged
+				? popUntagged( task )
+				: popTenant( *m_tenants[m_drrSlot - 1], task );
+			if ( bPopped )
+			{
+				if ( m_drrQuantum == 0 )
+				{
+					m_drrQuantum = m_drrSlot == untagged
+						? m_untaggedWeight
+						: m_tenants[m_drrSlot - 1]->weight;
+				}
+				if ( --m_drrQuantum == 0 )
+				{
+					m_drrSlot = ( m_drrSlot + 1 ) % nSlots;
+				}
+				return true;
+			}
+			// an empty queue forfeits the rest of its turn
+			m_drrQuantum = 0;
+			m_drrSlot = ( m_drrSlot + 1 ) % nSlots;
+		}
+		return false;
+	}
+	// alternates between m_tasks & the shards, so that neither a steady flow into m_tasks -
+	//	keyed hand backs, untagged tenant tasks, submissions while sharding is off - nor into
+	//	the shards starves the other
+	bool popUntagged( Task& task )
+	{
+		m_bShardTurn = !m_bShardTurn;
+		return m_bShardTurn
+			? popShard( task ) || m_tasks.pop( task )
+			: m_tasks.pop( task ) || popShard( task );
+	}
+	// takes a task from the next non empty shard; empty shards are skipped without locking them
+	bool popShard( Task& task )
+	{
+		const std::size_t nUsed = m_nShardsUsed.load( std::memory_order_relaxed );
+		for ( std::size_t n = 0; n < nUsed; ++n )
+		{
+			Shard& shard = m_shards[m_shardCursor];
+			m_shardCursor = ( m_shardCursor + 1 ) % nUsed;
+			if ( shard.nTasks.load( std::memory_order_relaxed ) == 0 )
+			{
+				continue;
+			}
+			std::lock_guard<std::mutex> lg{shard.mu};
+			if ( shard.tasks.pop( task ) )
+			{
+				shard.nTasks.store( shard.tasks.size(),
+					std::memory_order_relaxed );
+				return true;
+			}
+		}
+		return false;
+	}
+	// the parking worker's side of pushShard's handshake
+	bool isAnyShardOccupied() const noexcept
+	{
+		const std::size_t nUsed = m_nShardsUsed.load( std::memory_order_relaxed );
+		for ( std::size_t si = 0; si < nUsed; ++si )
+		{
+			if ( m_shards[si].nTasks.load() > 0 )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	std::size_t shardedTaskCount() const noexcept
+	{
+		std::size_t nQueued = 0;
+		const std::size_t nUsed = m_nShardsUsed.load( std::memory_order_relaxed );
+		for ( std::size_t si = 0; si < nUsed; ++si )
+		{
+			nQueued += m_shards[si].nTasks.load( std::memory_order_relaxed );
+		}
+		return nQueued;
+	}
+	static bool popTenant( Tenant& t, Task& task )
+	{
+		if ( t.tasks.empty() )
+		{
+			return false;
+		}
+		const auto wait = std::chrono::steady_clock::now() - t.tasks.front().second;
+		task = std::move( t.tasks.front().first );
+		t.tasks.pop_front();
+		++t.nExecuted;
+		t.totalWait += wait;
+		t.maxWait = std::max( t.maxWait, wait );
+		return true;
+	}
+	Tenant& tenantAt( TenantId tenant )
+	{
+		if ( tenant == untagged || tenant > m_tenants.size() )
+		{
+			throw std::out_of_range{"unknown tenant"};
+		}
+		return *m_tenants[tenant - 1];
+	}
+	void pushKeyed( std::size_t wi, Task task )
+	{
+		Worker& w = *m_workers[wi];
+		w.tasks.emplace_back( std::move( task ) );
+		if ( !w.bRunning )
+		{
+			startWorker( wi );
+		}
+		else if ( w.bIdle )
+		{
+			wakeWorker( wi );
+		}
+		else if ( w.tasks.size() > m_stealThreshold )
+		{// preferred worker is overloaded; let a parked one help
+			wakeIdleWorker();
+		}
+	}
+	void wakeIdleWorker()
+	{
+		if ( !m_idle.empty() )
+		{
+			wakeWorker( m_idle.back() );
+		}
+		else if ( m_bLazy
+			&& m_nStarted < m_nTarget.load( std::memory_order_relaxed )
+			&& stealableTaskCount() > m_nStarting + m_nWoken )
+		{// every started worker is busy & the backlog outnumbers those on their way to it - grow towards the maximum
+			startNextWorker();
+		}
+	}
+	void wakeWorker( std::size_t wi )
+	{
+		Worker& w = *m_workers[wi];
+		w.bIdle = false;
+		m_idle.erase( std::find( m_idle.begin(), m_idle.end(), wi ) );
+		m_nIdle.fetch_sub( 1 );
+		++m_nWoken;
+		w.bSignaled.store( true,
+			std::memory_order_release );
+		w.cond.notify_one();
+	}
+	// whether worker wi should look for tasks: it is within the thread count, or the pool is draining
+	bool isServing( std::size_t wi ) const noexcept
+	{
+		return M_ENABLED
+			? wi < m_nTarget.load( std::memory_order_relaxed )
+			: m_bDraining;
+	}
+	// claims slot wi; its thread is created by spawnPending once m_mu is released
+	void startWorker( std::size_t wi )
+	{
+		m_workers[wi]->bRunning = true;
+		++m_nStarted;
+		++m_nStarting;
+		m_spawns.push_back( wi );
+		m_bSpawnPending.store( true,
+			std::memory_order_relaxed );
+	}
+	// gives back a slot claimed by startWorker whose thread was never created
+	void releaseSlot( std::size_t wi )
+	{
+		Worker& w = *m_workers[wi];
+		w.bRunning = false;
+		--m_nStarted;
+		--m_nStarting;
+		while ( !w.tasks.empty() )
+		{
+			m_tasks.push( std::move( w.tasks.front() ) );
+			w.tasks.pop_front();
+		}
+	}
+	bool startNextWorker()
+	{
+		const std::size_t nTarget = m_nTarget.load( std::memory_order_relaxed );
+		if ( m_nStarted >= nTarget )
+		{
+			return false;
+		}
+		for ( std::size_t wi = 0; wi < nTarget; ++wi )
+		{
+			if ( !m_workers[wi]->bRunning )
+			{
+				startWorker( wi );
+				return true;
+			}
+		}
+		return false;
+	}
+	void retireWorker( std::size_t wi )
+	{
+		Worker& self = *m_workers[wi];
+		self.bRunning = false;
+		--m_nStarted;
+		// hand keyed tasks back to the shared queue
+		while ( !self.tasks.empty() )
+		{
+			m_tasks.push( std::move( self.tasks.front() ) );
+			self.tasks.pop_front();
+			if ( M_ENABLED )
+			{
+				wakeIdleWorker();
+			}
+		}
+	}
+	std::size_t clampThreadCount( std::size_t n ) const noexcept
+	{
+		return std::min( std::max( n,
+				std::size_t{1} ),
+			m_workers.size() );
+	}
+	void resizeTo( std::size_t n )
+	{
+		const std::size_t nPrev = m_nTarget.load( std::memory_order_relaxed );
+		m_nTarget.store( n,
+			std::memory_order_relaxed );
+		if ( n < nPrev )
+		{// parked workers past the new count wake up to retire themselves, busy ones do so after their task
+			for ( std::size_t wi = n; wi < nPrev; ++wi )
+			{
+				Worker& w = *m_workers[wi];
+				if ( w.bIdle )
+				{
+					wakeWorker( wi );
+				}
+				else if ( !w.bRunning )
+				{
+					while ( !w.tasks.empty() )
+					{
+						m_tasks.push( std::move( w.tasks.front() ) );
+						w.tasks.pop_front();
+					}
+				}
+			}
+		}
+		else if ( !m_bLazy )
+		{
+			while ( startNextWorker() );
+		}
+		else
+		{// a lazy pool starts workers for the backlog already queued, the rest as more arrives
+			std::size_t nStart = std::min( stealableTaskCount(),
+				n - std::min<std::size_t>( n, m_nStarted ) );
+			while ( nStart-- > 0 && startNextWorker() );
+		}
+	}
+	std::size_t queuedTaskCount() const noexcept
+	{
+		std::size_t nQueued = sharedTaskCount();
+		for ( auto& w : m_workers )
+		{
+			nQueued += w->tasks.size() + w->nBatched.load( std::memory_order_relaxed );
+		}
+		return nQueued;
+	}
+	// tasks in the untagged queue, the shards & the tenants' queues
+	std::size_t sharedTaskCount() const noexcept
+	{
+		std::size_t nQueued = m_tasks.size() + shardedTaskCount();
+		for ( auto& t : m_tenants )
+		{
+			nQueued += t->tasks.size();
+		}
+		return nQueued;
+	}
+	// tasks any worker may take: the shared ones & the keyed ones past the steal threshold
+	std::size_t stealableTaskCount() const noexcept
+	{
+		std::size_t nQueued = sharedTaskCount();
+		for ( auto& w : m_workers )
+		{
+			nQueued += w->tasks.size() - std::min( w->tasks.size(), m_stealThreshold );
+		}
+		return nQueued;
+	}
+	//===================================================
+	//	\function	spawnPending
+	//	\brief  creates the threads of the slots claimed by startWorker
+	//			called without m_mu by everyone who may have claimed one, so that a thread is never
+	//				created under the pool's lock; whoever comes first spawns the lot
+	//			a slot's previous thread may still be on its way out of threadMain - possibly it is
+	//				the caller - so the new thread joins it rather than us
+	//			never throws: a thread that cannot be created gives its slot back - its keyed tasks
+	//				to the shared queue - and the error is returned; queued tasks stay with the
+	//				running workers and a lazy pool tries again on the next submission
+	//	\date	18/10/2026
+	std::exception_ptr spawnPending() noexcept
+	{
+		if ( !m_bSpawnPending.load( std::memory_order_relaxed ) )
+		{
+			return nullptr;
+		}
+		std::lock_guard<std::mutex> spawnLock{m_spawnMu};
+		std::vector<std::size_t> spawns;
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			spawns.swap( m_spawns );
+			m_bSpawnPending.store( false,
+				std::memory_order_relaxed );
+			if ( !M_ENABLED )
+			{// stopped meanwhile
+				for ( std::size_t wi : spawns )
+				{
+					releaseSlot( wi );
+				}
+				return nullptr;
+			}
+		}
+		for ( auto it = spawns.begin(); it != spawns.end(); ++it )
+		{
+			Worker& w = *m_workers[*it];
+			std::shared_ptr<NativeThread> prev;
+			try
+			{
+				prev = std::make_shared<NativeThread>( std::move( w.thread ) );
+				w.thread = NativeThread{m_stackSize,
+					[this, wi = *it, prev] ()
+					{
+						if ( prev->joinable() )
+						{
+							prev->join();
+						}
+						threadMain( wi );
+					}};
+			}
+			catch ( ... )
+			{
+				if ( prev )
+				{
+					w.thread = std::move( *prev );
+				}
+				std::lock_guard<std::mutex> lg{m_mu};
+				for ( ; it != spawns.end(); ++it )
+				{
+					releaseSlot( *it );
+				}
+				// the keyed tasks handed back may be all a parked worker would get
+				if ( !m_tasks.empty() && !m_idle.empty() )
+				{
+					wakeWorker( m_idle.back() );
+				}
+				return std::current_exception();
+			}
+		}
+		return nullptr;
+	}
+
+	struct LabelScope
+	{
+		Worker& w;
+
+		LabelScope( Worker& worker, const char* label ) noexcept
+			:
+			w{worker}
+		{
+			w.taskLabel.store( label,
+				std::memory_order_relaxed );
+		}
+		~LabelScope() noexcept
+		{
+			w.taskLabel.store( nullptr,
+				std::memory_order_relaxed );
+		}
+	};
+};
\ No newline at end of file
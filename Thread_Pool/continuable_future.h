@@ -0,0 +1,571 @@
+#pragma once
+
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <optional>
+#include <variant>
+#include <exception>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "thread_pool.h"
+
+
+template<typename T, typename Pool>
+class ContinuableFuture;
+
+namespace continuation_detail
+{
+
+//============================================================
+//	\class	State
+//
+//	\brief	the result slot shared by a producer and its ContinuableFuture
+//			holds at most one continuation; it runs on the thread that completes the state,
+//				or right away on the registering thread if the state is already complete
+//=============================================================
+template<typename T>
+struct State
+{
+	using Value = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+	std::mutex mu;
+	std::condition_variable cond;
+	std::optional<Value> value;
+	std::exception_ptr error;
+	bool bReady = false;
+	UniqueFunction continuation;
+
+	template<typename... V>
+	void setValue( V&&... v )
+	{
+		UniqueFunction next;
+		{
+			std::lock_guard<std::mutex> lg{mu};
+			value.emplace( std::forward<V>( v )... );
+			bReady = true;
+			next = std::move( continuation );
+		}
+		cond.notify_all();
+		if ( next )
+		{
+			next();
+		}
+	}
+
+	void setError( std::exception_ptr e )
+	{
+		UniqueFunction next;
+		{
+			std::lock_guard<std::mutex> lg{mu};
+			error = e;
+			bReady = true;
+			next = std::move( continuation );
+		}
+		cond.notify_all();
+		if ( next )
+		{
+			next();
+		}
+	}
+
+	// f must not throw
+	void onReady( UniqueFunction f )
+	{
+		{
+			std::lock_guard<std::mutex> lg{mu};
+			if ( !bReady )
+			{
+				continuation = std::move( f );
+				return;
+			}
+		}
+		f();
+	}
+};
+
+// runs f and completes st with its result or exception
+template<typename T, typename F, typename... TArgs>
+void fulfil( State<T>& st,
+	F& f,
+	TArgs&&... args ) noexcept
+{
+	try
+	{
+		if constexpr ( std::is_void_v<T> )
+		{
+			std::invoke( f,
+				std::forward<TArgs>( args )... );
+			st.setValue();
+		}
+		else
+		{
+			st.setValue( std::invoke( f,
+				std::forward<TArgs>( args )... ) );
+		}
+	}
+	catch ( ... )
+	{
+		st.setError( std::current_exception() );
+	}
+}
+
+template<typename F, typename T>
+struct ThenResult
+{
+	using type = std::invoke_result_t<F, T&&>;
+};
+
+template<typename F>
+struct ThenResult<F, void>
+{
+	using type = std::invoke_result_t<F>;
+};
+
+// fan-in bookkeeping of the combinators - the last input to arrive completes out
+template<typename Out>
+struct Countdown
+{
+	std::atomic<std::size_t> nRemaining;
+	std::atomic<bool> bFailed{false};
+	std::exception_ptr error;		// written by the single input that set bFailed
+	std::shared_ptr<State<Out>> out = std::make_shared<State<Out>>();
+
+	explicit Countdown( std::size_t n )
+		:
+		nRemaining{n}
+	{
+
+	}
+
+	void fail( std::exception_ptr e ) noexcept
+	{
+		if ( !bFailed.exchange( true,
+			std::memory_order_acq_rel ) )
+		{
+			error = e;
+		}
+	}
+
+	// true for the last input
+	bool arrive() noexcept
+	{
+		return nRemaining.fetch_sub( 1,
+			std::memory_order_acq_rel ) == 1;
+	}
+};
+
+// lets the combinators reach a future's internals
+struct Access
+{
+	template<typename T, typename Pool>
+	static std::shared_ptr<State<T>> release( ContinuableFuture<T, Pool>& fu ) noexcept
+	{
+		return std::move( fu.m_state );
+	}
+
+	template<typename T, typename Pool>
+	static Pool* pool( const ContinuableFuture<T, Pool>& fu ) noexcept
+	{
+		return fu.m_pPool;
+	}
+
+	template<typename T, typename Pool>
+	static ContinuableFuture<T, Pool> make( Pool* pPool,
+		std::shared_ptr<State<T>> st ) noexcept
+	{
+		return ContinuableFuture<T, Pool>{pPool, std::move( st )};
+	}
+};
+
+}// namespace continuation_detail
+
+
+//============================================================
+//	\class	ContinuableFuture
+//
+//	\author	KeyC0de
+//	\date	18/10/2026
+//
+//	\brief	The result of a task started with spawn() on a ThreadPool - or any BasicThreadPool
+//			Besides blocking get() it takes a continuation with then(), which is queued on
+//				the pool as soon as the result is ready; no thread waits in between
+//			whenAll & whenAny join several futures the same way, counting inputs down atomically
+//			An exception propagates along a chain of continuations, skipping them, to get()
+//			Move only; get() and then() consume the future
+//=============================================================
+template<typename T, typename Pool = ThreadPool>
+class ContinuableFuture final
+{
+	using State = continuation_detail::State<T>;
+
+	friend struct continuation_detail::Access;
+
+	Pool* m_pPool = nullptr;
+	std::shared_ptr<State> m_state;
+
+	ContinuableFuture( Pool* pPool,
+		std::shared_ptr<State> st ) noexcept
+		:
+		m_pPool{pPool},
+		m_state{std::move( st )}
+	{
+
+	}
+public:
+	ContinuableFuture() noexcept = default;
+	ContinuableFuture( ContinuableFuture&& ) noexcept = default;
+	ContinuableFuture& operator=( ContinuableFuture&& ) noexcept = default;
+	ContinuableFuture( const ContinuableFuture& ) = delete;
+	ContinuableFuture& operator=( const ContinuableFuture& ) = delete;
+
+	bool valid() const noexcept
+	{
+		return m_state != nullptr;
+	}
+
+	bool isReady() const
+	{
+		std::lock_guard<std::mutex> lg{m_state->mu};
+		return m_state->bReady;
+	}
+
+	void wait() const
+	{
+		std::unique_lock<std::mutex> ul{m_state->mu};
+		m_state->cond.wait( ul,
+			[this] () { return m_state->bReady; } );
+	}
+
+	//===================================================
+	//	\function	get
+	//	\brief  blocks until the result is ready and returns it, or rethrows the task's exception
+	//	\date	18/10/2026
+	T get()
+	{
+		wait();
+		std::shared_ptr<State> st = std::move( m_state );
+		if ( st->error )
+		{
+			std::rethrow_exception( st->error );
+		}
+		if constexpr ( !std::is_void_v<T> )
+		{
+			return std::move( *st->value );
+		}
+	}
+
+	//===================================================
+	//	\function	then
+	//	\brief  queues f( result ) - or f() for a void future - on the pool once the result is ready
+	//			returns the future of f's result; if this future failed f is skipped and the
+	//				exception is passed on
+	//			a future that has no pool - whenAll of nothing - runs f on the calling thread
+	//	\date	18/10/2026
+	template<typename Callback>
+	auto then( Callback&& f )
+	{
+		using R = typename continuation_detail::ThenResult<std::decay_t<Callback>, T>::type;
+		using NextState = continuation_detail::State<R>;
+
+		std::shared_ptr<NextState> next = std::make_shared<NextState>();
+		std::shared_ptr<State> prev = std::move( m_state );
+		State& prevRef = *prev;
+		Pool* pPool = m_pPool;
+
+		auto step = [prev, next, f = std::forward<Callback>( f )] () mutable
+		{
+			if ( prev->error )
+			{
+				next->setError( prev->error );
+			}
+			else if constexpr ( std::is_void_v<T> )
+			{
+				continuation_detail::fulfil( *next,
+					f );
+			}
+			else
+			{
+				continuation_detail::fulfil( *next,
+					f,
+					std::move( *prev->value ) );
+			}
+		};
+		// prev holds itself through its continuation until it completes
+		prevRef.onReady( [pPool, next, step = std::move( step )] () mutable
+		{
+			if ( pPool == nullptr )
+			{
+				step();
+				return;
+			}
+			try
+			{
+				pPool->enqueue( std::move( step ) );
+			}
+			catch ( ... )
+			{// the pool was disabled meanwhile
+				next->setError( std::current_exception() );
+			}
+		} );
+		return continuation_detail::Access::make( pPool,
+			std::move( next ) );
+	}
+};
+
+
+//===================================================
+//	\function	spawn
+//	\brief  enqueues f( args... ) on pool and returns a ContinuableFuture of its result
+//	\date	18/10/2026
+template<typename Pool, typename Callback, typename... TArgs>
+auto spawn( Pool& pool,
+	Callback&& f,
+	TArgs&&... args )
+{
+	using R = std::invoke_result_t<std::decay_t<Callback>, std::decay_t<TArgs>...>;
+	using State = continuation_detail::State<R>;
+
+	std::shared_ptr<State> st = std::make_shared<State>();
+	pool.enqueue( [st, f = std::forward<Callback>( f ),
+			args = std::make_tuple( std::forward<TArgs>( args )... )] () mutable
+		{
+			std::apply( [&st, &f] ( auto&&... a )
+				{
+					continuation_detail::fulfil( *st,
+						f,
+						std::forward<decltype( a )>( a )... );
+				},
+				std::move( args ) );
+		} );
+	return continuation_detail::Access::make( &pool,
+		std::move( st ) );
+}
+
+//===================================================
+//	\function	whenAll
+//	\brief  a future of every input's result, in input order, ready once the last input is
+//			fails with the first failure observed, after all inputs have completed
+//			the inputs are consumed
+//	\date	18/10/2026
+template<typename T, typename Pool>
+auto whenAll( std::vector<ContinuableFuture<T, Pool>> futures )
+{
+	using Out = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+	using Access = continuation_detail::Access;
+	using Values = std::conditional_t<std::is_void_v<T>, std::monostate, std::vector<std::optional<T>>>;
+
+	struct Join
+		: continuation_detail::Countdown<Out>
+	{
+		Values values;
+
+		using continuation_detail::Countdown<Out>::Countdown;
+
+		void finish()
+		{
+			if ( this->error )
+			{
+				this->out->setError( this->error );
+			}
+			else if constexpr ( std::is_void_v<T> )
+			{
+				this->out->setValue();
+			}
+			else
+			{
+				std::vector<T> result;
+				result.reserve( values.size() );
+				for ( auto& v : values )
+				{
+					result.emplace_back( std::move( *v ) );
+				}
+				this->out->setValue( std::move( result ) );
+			}
+		}
+	};
+
+	Pool* pPool = futures.empty() ? nullptr : Access::pool( futures.front() );
+	std::shared_ptr<Join> join = std::make_shared<Join>( futures.size() );
+	if constexpr ( !std::is_void_v<T> )
+	{
+		join->values.resize( futures.size() );
+	}
+	auto result = Access::make( pPool,
+		join->out );
+	if ( futures.empty() )
+	{
+		join->finish();
+		return result;
+	}
+	for ( std::size_t i = 0; i < futures.size(); ++i )
+	{
+		// the input state is alive while its continuation runs
+		auto st = Access::release( futures[i] );
+		auto* p = st.get();
+		p->onReady( [join, p, i] ()
+		{
+			if ( p->error )
+			{
+				join->fail( p->error );
+			}
+			else if constexpr ( !std::is_void_v<T> )
+			{
+				join->values[i].emplace( std::move( *p->value ) );
+			}
+			if ( join->arrive() )
+			{
+				join->finish();
+			}
+		} );
+	}
+	return result;
+}
+
+namespace continuation_detail
+{
+
+template<std::size_t I, typename Join, typename T, typename Pool>
+void attachOne( const std::shared_ptr<Join>& join,
+	ContinuableFuture<T, Pool>& fu )
+{
+	auto st = Access::release( fu );
+	auto* p = st.get();
+	p->onReady( [join, p] ()
+	{
+		if ( p->error )
+		{
+			join->fail( p->error );
+		}
+		else
+		{
+			std::get<I>( join->values ).emplace( std::move( *p->value ) );
+		}
+		if ( join->arrive() )
+		{
+			join->finish();
+		}
+	} );
+}
+
+template<typename Join, std::size_t... Is, typename... Futures>
+void attachAll( const std::shared_ptr<Join>& join,
+	std::index_sequence<Is...>,
+	Futures&... futures )
+{
+	( attachOne<Is>( join, futures ), ... );
+}
+
+}// namespace continuation_detail
+
+//===================================================
+//	\function	whenAll
+//	\brief  a future of a tuple of the inputs' results; the inputs must not be void
+//	\date	18/10/2026
+template<typename Pool, typename... Ts>
+ContinuableFuture<std::tuple<Ts...>, Pool> whenAll( ContinuableFuture<Ts, Pool>... futures )
+{
+	using Out = std::tuple<Ts...>;
+	static_assert( sizeof...( Ts ) > 0 && ( !std::is_void_v<Ts> && ... ),
+		"whenAll of a pack takes one or more non void futures" );
+
+	struct Join
+		: continuation_detail::Countdown<Out>
+	{
+		std::tuple<std::optional<Ts>...> values;
+
+		using continuation_detail::Countdown<Out>::Countdown;
+
+		void finish()
+		{
+			if ( this->error )
+			{
+				this->out->setError( this->error );
+				return;
+			}
+			this->out->setValue( std::apply( [] ( auto&... v ) { return Out{std::move( *v )...}; },
+				values ) );
+		}
+	};
+
+	Pool* pPool = nullptr;
+	( ( pPool = continuation_detail::Access::pool( futures ) ), ... );
+	std::shared_ptr<Join> join = std::make_shared<Join>( sizeof...( Ts ) );
+	auto result = continuation_detail::Access::make( pPool,
+		join->out );
+	continuation_detail::attachAll( join,
+		std::index_sequence_for<Ts...>{},
+		futures... );
+	return result;
+}
+
+template<typename T>
+struct WhenAnyResult
+{
+	std::size_t index;
+	T value;
+};
+
+template<>
+struct WhenAnyResult<void>
+{
+	std::size_t index;
+};
+
+//===================================================
+//	\function	whenAny
+//	\brief  a future of the index & result of the first input to complete
+//			fails if that input failed; the results of the others are discarded
+//			throws std::invalid_argument if futures is empty - no input could ever win the race
+//	\date	18/10/2026
+template<typename T, typename Pool>
+ContinuableFuture<WhenAnyResult<T>, Pool> whenAny( std::vector<ContinuableFuture<T, Pool>> futures )
+{
+	if ( futures.empty() )
+	{
+		throw std::invalid_argument{"whenAny needs at least one future"};
+	}
+	using Out = WhenAnyResult<T>;
+	using Access = continuation_detail::Access;
+
+	struct Race
+	{
+		std::atomic<bool> bDone{false};
+		std::shared_ptr<continuation_detail::State<Out>> out = std::make_shared<continuation_detail::State<Out>>();
+	};
+
+	std::shared_ptr<Race> race = std::make_shared<Race>();
+	auto result = Access::make( Access::pool( futures.front() ),
+		race->out );
+	for ( std::size_t i = 0; i < futures.size(); ++i )
+	{
+		auto st = Access::release( futures[i] );
+		auto* p = st.get();
+		p->onReady( [race, p, i] ()
+		{
+			if ( race->bDone.exchange( true,
+				std::memory_order_acq_rel ) )
+			{
+				return;
+			}
+			if ( p->error )
+			{
+				race->out->setError( p->error );
+			}
+			else if constexpr ( std::is_void_v<T> )
+			{
+				race->out->setValue( Out{i} );
+			}
+			else
+			{
+				race->out->setValue( Out{i, std::move( *p->value )} );
+			}
+		} );
+	}
+	return result;
+}
@@ -1,6 +1,17 @@
 #include <iostream>
 #include <sstream>
+#include <numeric>
 #include "thread_pool.h"
+#include "pipeline.h"
+#include "parallel_algorithms.h"
+#include "worker_local.h"
+#include "continuable_future.h"
+#include "single_flight.h"
+#if defined __linux__
+#	include <sys/socket.h>
+#	include <unistd.h>
+#	include "reactor.h"
+#endif
 #if defined _DEBUG && !defined NDEBUG
 #	pragma comment( lib, "C:/Program Files (x86)/Visual Leak Detector/lib/Win64/vld.lib" )
 #	include <C:/Program Files (x86)/Visual Leak Detector/include/vld.h>
@@ -46,12 +57,84 @@ int vv() { std::puts("nothing"); return 0; }
 int vs(const std::string& str) { std::puts(str.c_str()); return 0; }
 
 
+// micro tasks per second through the pool for a given dequeue batch size
+template<typename Pool>
+double microTaskThroughput( Pool& pool,
+	std::size_t maxBatch,
+	std::size_t nTasks )
+{
+	pool.setMaxBatch( maxBatch );
+	std::atomic<std::size_t> nDone{0};
+	std::vector<std::future<void>> results;
+	results.reserve( nTasks );
+	const auto start = std::chrono::steady_clock::now();
+	for ( std::size_t i = 0; i < nTasks; ++i )
+	{
+		results.emplace_back( pool.enqueue( [&nDone] ()
+		{
+			nDone.fetch_add( 1,
+				std::memory_order_relaxed );
+		} ) );
+	}
+	for ( auto& fu : results )
+	{
+		fu.get();
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return nTasks / elapsed.count();
+}
+
+// tasks per second submitted by nProducers threads at once, until all of them ran
+template<typename Pool>
+double submissionThroughput( Pool& pool,
+	std::size_t nShards,
+	std::size_t nProducers,
+	std::size_t nTasksPerProducer )
+{
+	pool.setSubmissionShards( nShards );
+	std::vector<std::vector<std::future<void>>> results( nProducers );
+	std::vector<std::thread> producers;
+	const auto start = std::chrono::steady_clock::now();
+	for ( std::size_t p = 0; p < nProducers; ++p )
+	{
+		producers.emplace_back( [&pool, &results, p, nTasksPerProducer] ()
+		{
+			results[p].reserve( nTasksPerProducer );
+			for ( std::size_t i = 0; i < nTasksPerProducer; ++i )
+			{
+				results[p].emplace_back( pool.enqueue( [] () {} ) );
+			}
+		} );
+	}
+	for ( auto& t : producers )
+	{
+		t.join();
+	}
+	for ( auto& producerResults : results )
+	{
+		for ( auto& fu : producerResults )
+		{
+			fu.get();
+		}
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	pool.setSubmissionShards( 0 );
+	return nProducers * nTasksPerProducer / elapsed.count();
+}
 
 int main()
 {
 	std::cout.sync_with_stdio( false );
 
-	ThreadPool& threadPool = ThreadPool::getInstance( std::thread::hardware_concurrency() );
+	// lazy pool with 256KB stacks - workers are spawned as the queue backs up
+	ThreadPool& threadPool = ThreadPool::getInstance( std::thread::hardware_concurrency(),
+		true,
+		true,
+		256 * 1024 );
+	// let the pool find its own thread count
+	threadPool.startController();
+	// complain about tasks hogging a worker for over a second
+	threadPool.startWatchdog();
 	threadPool.enqueue( spitId );
 	threadPool.enqueue( &spitId );
 	threadPool.enqueue( sayAndNoReturn );
@@ -62,7 +145,8 @@ int main()
 		return 1;
 	});
 	
-	auto sayWhatRet = threadPool.enqueue( sayWhat,
+	auto sayWhatRet = threadPool.enqueueLabeled( "sayWhat",
+		sayWhat,
 		100 );
 	
 	Member member{ 1 };
@@ -101,6 +185,307 @@ int main()
 		ex.what();
 	}
 
+	// keyed submission - all tasks of a key prefer the same worker
+	std::vector<std::future<void>> keyedResults;
+	for ( int i = 0; i < 64; ++i )
+	{
+		keyedResults.emplace_back( threadPool.enqueueWithKey( i % 4,
+			spitId ) );
+	}
+	for ( auto& fu : keyedResults )
+	{
+		fu.get();
+	}
+	std::cout << "locality hit rate = " << threadPool.localityHitRate() << '\n';
+
+	// bounded pipeline: serial read -> parallel transform -> in-order write
+	int nRead = 0;
+	long long sum = 0;
+	Pipeline<long long> pipeline{threadPool,
+		[&nRead] ( long long& item )
+		{
+			item = nRead++;
+			return nRead <= 1000;
+		}};
+	pipeline.addStage( StageMode::Parallel,
+			[] ( long long& item ) { item *= item; } )
+		.addStage( StageMode::SerialInOrder,
+			[&sum] ( long long& item ) { sum += item; } );
+	pipeline.run( 16 );
+	std::cout << "pipeline sum = " << sum << '\n';
+
+	// parallel algorithms sharing the same pool
+	std::vector<int> data( 1 << 20 );
+	for ( std::size_t i = 0; i < data.size(); ++i )
+	{
+		data[i] = static_cast<int>( ( i * 2654435761u ) % 100000 );
+	}
+	parallel::sort( threadPool,
+		data.begin(),
+		data.end() );
+	std::cout << "sorted = " << std::is_sorted( data.begin(), data.end() ) << '\n';
+	std::vector<long long> prefix( data.size() );
+	parallel::exclusiveScan( threadPool,
+		data.begin(),
+		data.end(),
+		prefix.begin(),
+		0ll );
+	std::cout << "scan total = " << prefix.back() + data.back() << '\n';
+	std::cout << "evens = " << parallel::countIf( threadPool,
+		data.begin(),
+		data.end(),
+		[] ( int v ) { return v % 2 == 0; } ) << '\n';
+	auto it = parallel::findIf( threadPool,
+		data.begin(),
+		data.end(),
+		[] ( int v ) { return v >= 50000; } );
+	std::cout << "first >= 50000 at " << ( it - data.begin() ) << '\n';
+
+	// benchmarks get a pool of their own: every worker started up front & no controller resizing it
+	using BenchPool = BasicThreadPool<FifoQueue, BlockingIdle, UniqueTask>;
+	const std::size_t nCores = std::max( std::thread::hardware_concurrency(), 1u );
+	BenchPool& benchPool = BenchPool::getInstance( nCores );
+	if ( nCores < 2 )
+	{
+		std::cout << "only 1 hardware thread: the figures below show per task overhead, not contention between cores\n";
+	}
+
+	// batched dequeue: one lock acquisition per batch instead of per micro task
+	for ( std::size_t maxBatch : {1, 4, 16, 64} )
+	{
+		std::cout << "max batch " << maxBatch << ": "
+			<< static_cast<long long>( microTaskThroughput( benchPool, maxBatch, 200000 ) ) << " tasks/s on "
+			<< benchPool.threadCount() << " threads\n";
+	}
+	benchPool.setMaxBatch( 1 );
+
+	// producer side contention: one submission queue versus a shard per producer
+	for ( std::size_t nProducers = 1; nProducers <= 64; nProducers *= 2 )
+	{
+		std::cout << nProducers << " producers on " << benchPool.threadCount() << " threads: single queue "
+			<< static_cast<long long>( submissionThroughput( benchPool, 0, nProducers, 200000 / nProducers ) )
+			<< " tasks/s, sharded "
+			<< static_cast<long long>( submissionThroughput( benchPool, std::min<std::size_t>( nProducers, BenchPool::maxShards ), nProducers, 200000 / nProducers ) )
+			<< " tasks/s\n";
+	}
+
+	// a noisy tenant floods the pool; the interactive one still gets its turn every round
+	{
+		const ThreadPool::TenantId batch = threadPool.addTenant( 1 );
+		const ThreadPool::TenantId interactive = threadPool.addTenant( 4 );
+		std::vector<std::future<void>> tenantResults;
+		auto spin = [] ()
+		{
+			std::this_thread::sleep_for( std::chrono::microseconds{200} );
+		};
+		for ( int i = 0; i < 400; ++i )
+		{
+			tenantResults.emplace_back( threadPool.enqueueForTenant( batch,
+				spin ) );
+		}
+		for ( int i = 0; i < 40; ++i )
+		{
+			tenantResults.emplace_back( threadPool.enqueueForTenant( interactive,
+				spin ) );
+		}
+		for ( auto& fu : tenantResults )
+		{
+			fu.get();
+		}
+		for ( ThreadPool::TenantId tenant : {batch, interactive} )
+		{
+			const auto stats = threadPool.tenantStats( tenant );
+			std::cout << "tenant " << tenant << ": executed " << stats.nExecuted
+				<< ", mean wait " << stats.meanWait.count() / 1000 << "us"
+				<< ", max wait " << stats.maxWait.count() / 1000 << "us\n";
+		}
+	}
+
+	// bulk synchronous phases: the same participants run every iteration, meeting at a spin barrier
+	//	compared with a round of tasks & futures per iteration running the same phases
+	{
+		constexpr std::size_t nIterations = 2000;
+		const std::size_t nWorkers = std::min( benchPool.threadCount(), nCores );
+		std::vector<double> grid( 1 << 16 ), next( grid.size() );
+		auto reset = [&grid, &next] ()
+		{
+			std::fill( grid.begin(), grid.end(), 0.0 );
+			std::fill( next.begin(), next.end(), 0.0 );
+			grid.front() = grid.back() = 1.0;
+			next.front() = next.back() = 1.0;
+		};
+		// one Jacobi sweep per phase, ping-ponging between the buffers
+		auto sweep = [&grid, &next] ( std::size_t participant, std::size_t nParticipants, std::size_t it )
+		{
+			const std::vector<double>& in = it % 2 == 0 ? grid : next;
+			std::vector<double>& out = it % 2 == 0 ? next : grid;
+			const std::size_t n = in.size() - 2;
+			const std::size_t b = 1 + n * participant / nParticipants;
+			const std::size_t e = 1 + n * ( participant + 1 ) / nParticipants;
+			for ( std::size_t i = b; i < e; ++i )
+			{
+				out[i] = 0.5 * ( in[i - 1] + in[i + 1] );
+			}
+		};
+
+		reset();
+		auto start = std::chrono::steady_clock::now();
+		parallel::runPhases( benchPool,
+			nWorkers,
+			sweep,
+			nIterations );
+		const auto phased = std::chrono::steady_clock::now() - start;
+
+		reset();
+		start = std::chrono::steady_clock::now();
+		for ( std::size_t it = 0; it < nIterations; ++it )
+		{
+			std::vector<std::future<void>> round;
+			for ( std::size_t participant = 1; participant < nWorkers; ++participant )
+			{
+				round.emplace_back( benchPool.enqueue( [&sweep, participant, nWorkers, it] ()
+				{
+					sweep( participant,
+						nWorkers,
+						it );
+				} ) );
+			}
+			sweep( 0,
+				nWorkers,
+				it );
+			for ( auto& fu : round )
+			{
+				fu.get();
+			}
+		}
+		const auto joined = std::chrono::steady_clock::now() - start;
+		using std::chrono::nanoseconds;
+		std::cout << nWorkers << " participants, per sweep: runPhases "
+			<< std::chrono::duration_cast<nanoseconds>( phased ).count() / nIterations
+			<< "ns, enqueue & join " << std::chrono::duration_cast<nanoseconds>( joined ).count() / nIterations
+			<< "ns\n";
+	}
+
+	// capture the next section's tasks for offline tuning
+	threadPool.startRecording( "workload.tpwl" );
+
+	// per-worker partial sums, merged at the end
+	WorkerLocal<long long> partialSums{threadPool, 0};
+	std::vector<std::future<void>> partialResults;
+	for ( int i = 1; i <= 1000; ++i )
+	{
+		partialResults.emplace_back( threadPool.enqueue( [&partialSums, i] ()
+		{
+			partialSums.local() += i;
+		} ) );
+	}
+	for ( auto& fu : partialResults )
+	{
+		fu.get();
+	}
+	std::cout << "worker local sum = " << partialSums.combine( 0ll,
+		std::plus<>{} ) << '\n';
+	threadPool.stopRecording();
+
+	// replay the captured traffic shape against another pool configuration
+	{
+		using LifoPool = BasicThreadPool<LifoQueue, BlockingIdle, FunctionTask>;
+		const ReplayReport report = replayWorkload( LifoPool::getInstance( 2 ),
+			loadWorkload( "workload.tpwl" ) );
+		std::cout << "replayed " << report.nTasks << " tasks in "
+			<< std::chrono::duration_cast<std::chrono::microseconds>( report.makespan ).count() << "us, mean wait "
+			<< report.meanWait.count() << "ns, p99 wait "
+			<< report.p99Wait.count() << "ns\n";
+	}
+
+	// fan-in without a waiting thread: the sum is queued once the last part is done
+	std::vector<ContinuableFuture<long long>> parts;
+	for ( long long i = 0; i < 8; ++i )
+	{
+		parts.emplace_back( spawn( threadPool,
+			[] ( long long base )
+			{
+				long long s = 0;
+				for ( long long v = base; v < base + 1000; ++v )
+				{
+					s += v;
+				}
+				return s;
+			},
+			i * 1000 ) );
+	}
+	auto total = whenAll( std::move( parts ) ).then( [] ( std::vector<long long> sums )
+	{
+		return std::accumulate( sums.begin(), sums.end(), 0ll );
+	} );
+	std::cout << "continuation sum = " << total.get() << '\n';
+	std::vector<ContinuableFuture<int>> racers;
+	racers.emplace_back( spawn( threadPool, [] () { std::this_thread::sleep_for( std::chrono::milliseconds{50} ); return 0; } ) );
+	racers.emplace_back( spawn( threadPool, [] () { return 1; } ) );
+	std::cout << "first racer = " << whenAny( std::move( racers ) ).get().index << '\n';
+
+	// a thundering herd of identical lookups runs once; repeats within a second hit the cache
+	{
+		SingleFlight<int, long long> lookups{threadPool, 128, std::chrono::seconds{1}};
+		std::vector<std::shared_future<long long>> herd;
+		for ( int i = 0; i < 32; ++i )
+		{
+			herd.emplace_back( lookups.enqueueOnce( i % 2,
+				[key = i % 2] ()
+				{
+					std::this_thread::sleep_for( std::chrono::milliseconds{20} );
+					return key * 1000ll;
+				} ) );
+		}
+		for ( auto& fu : herd )
+		{
+			fu.get();
+		}
+		lookups.enqueueOnce( 1, [] () { return 1000ll; } ).get();
+		const auto stats = lookups.stats();
+		std::cout << "single flight: executed " << stats.nExecuted
+			<< ", shared " << stats.nShared
+			<< ", cache hits " << stats.nCacheHits << '\n';
+	}
+
+	// a pool built for short-lived, move-only tasks: newest first, spin before sleeping
+	{
+		using MicroTaskPool = BasicThreadPool<LifoQueue, SpinningIdle<>, UniqueTask>;
+		MicroTaskPool& microPool = MicroTaskPool::getInstance( 4 );
+		auto owned = std::make_unique<int>( 42 );
+		auto fu = microPool.enqueue( [p = std::move( owned )] () { return *p; } );
+		std::cout << "micro pool says " << fu.get() << '\n';
+	}
+
+#if defined __linux__
+	// readiness events on a socketpair are handled by pool workers
+	{
+		int sv[2];
+		socketpair( AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv );
+		std::promise<std::string> received;
+		Reactor reactor{threadPool};
+		reactor.add( sv[1],
+			EPOLLIN,
+			[&received] ( int fd, std::uint32_t )
+			{
+				std::string msg;
+				char buf[64];
+				ssize_t n;
+				while ( ( n = read( fd, buf, sizeof buf ) ) > 0 )
+				{
+					msg.append( buf, n );
+				}
+				received.set_value( msg );
+			} );
+		reactor.start();
+		[[maybe_unused]] ssize_t n = write( sv[0], "ping", 4 );
+		std::cout << "reactor received " << received.get_future().get() << '\n';
+		reactor.stop();
+		close( sv[0] );
+		close( sv[1] );
+	}
+#endif
+
 #if defined _DEBUG && !defined NDEBUG
 	while ( !getchar() );
 #endif
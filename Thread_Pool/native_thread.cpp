@@ -0,0 +1,126 @@
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include "native_thread.h"
+#if defined _WIN32
+#	include "winner.h"
+#	include <process.h>
+#else
+#	include <climits>
+#	include <unistd.h>
+#endif
+
+
+namespace
+{
+
+#if defined _WIN32
+unsigned __stdcall threadProc( void* arg )
+#else
+void* threadProc( void* arg )
+#endif
+{
+	std::unique_ptr<std::function<void()>> f{static_cast<std::function<void()>*>( arg )};
+	( *f )();
+#if defined _WIN32
+	return 0;
+#else
+	return nullptr;
+#endif
+}
+
+}// namespace
+
+
+NativeThread::NativeThread( std::size_t stackSize,
+	std::function<void()> f )
+{
+	auto pf = std::make_unique<std::function<void()>>( std::move( f ) );
+#if defined _WIN32
+	// reserve only - pages are committed as the stack grows
+	const uintptr_t h = _beginthreadex( nullptr,
+		static_cast<unsigned>( stackSize ),
+		&threadProc,
+		pf.get(),
+		stackSize != 0 ? STACK_SIZE_PARAM_IS_A_RESERVATION : 0,
+		nullptr );
+	if ( h == 0 )
+	{
+		throw std::system_error{errno, std::generic_category(), "_beginthreadex failed"};
+	}
+	m_handle = reinterpret_cast<void*>( h );
+#else
+	pthread_attr_t attr;
+	pthread_attr_init( &attr );
+	if ( stackSize != 0 )
+	{
+		const std::size_t pageSize = static_cast<std::size_t>( sysconf( _SC_PAGESIZE ) );
+		stackSize = std::max<std::size_t>( stackSize, PTHREAD_STACK_MIN );
+		stackSize = ( stackSize + pageSize - 1 ) / pageSize * pageSize;
+		pthread_attr_setstacksize( &attr,
+			stackSize );
+	}
+	const int err = pthread_create( &m_handle,
+		&attr,
+		&threadProc,
+		pf.get() );
+	pthread_attr_destroy( &attr );
+	if ( err != 0 )
+	{
+		throw std::system_error{err, std::generic_category(), "pthread_create failed"};
+	}
+#endif
+	pf.release();
+	m_bJoinable = true;
+}
+
+NativeThread::~NativeThread() noexcept
+{
+	if ( m_bJoinable )
+	{// like std::thread destroying a running thread is a logic error
+		std::terminate();
+	}
+}
+
+NativeThread::NativeThread( NativeThread&& rhs ) noexcept
+	:
+	m_handle{rhs.m_handle},
+	m_bJoinable{std::exchange( rhs.m_bJoinable, false )}
+{
+
+}
+
+NativeThread& NativeThread::operator=( NativeThread&& rhs ) noexcept
+{
+	if ( m_bJoinable )
+	{
+		std::terminate();
+	}
+	m_handle = rhs.m_handle;
+	m_bJoinable = std::exchange( rhs.m_bJoinable, false );
+	return *this;
+}
+
+bool NativeThread::joinable() const noexcept
+{
+	return m_bJoinable;
+}
+
+void NativeThread::join()
+{
+	if ( !m_bJoinable )
+	{
+		throw std::system_error{std::make_error_code( std::errc::invalid_argument ), "thread not joinable"};
+	}
+#if defined _WIN32
+	WaitForSingleObject( m_handle,
+		INFINITE );
+	CloseHandle( m_handle );
+#else
+	pthread_join( m_handle,
+		nullptr );
+#endif
+	m_bJoinable = false;
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#if !defined _WIN32
+#	include <pthread.h>
+#endif
+
+
+//============================================================
+//	\class	NativeThread
+//
+//	\author	KeyC0de
+//	\date	18/10/2026
+//
+//	\brief	A minimal joinable thread whose stack size can be chosen at creation
+//			std::thread always uses the platform default stack (1MB on Windows, 8MB on Linux)
+//			stackSize == 0 keeps the platform default
+//			Move only class
+//=============================================================
+class NativeThread final
+{
+#if defined _WIN32
+	void* m_handle = nullptr;
+#else
+	pthread_t m_handle{};
+#endif
+	bool m_bJoinable = false;
+public:
+	NativeThread() noexcept = default;
+	NativeThread( std::size_t stackSize, std::function<void()> f );
+	~NativeThread() noexcept;
+	NativeThread( const NativeThread& ) = delete;
+	NativeThread& operator=( const NativeThread& ) = delete;
+	NativeThread( NativeThread&& rhs ) noexcept;
+	NativeThread& operator=( NativeThread&& rhs ) noexcept;
+
+	bool joinable() const noexcept;
+	void join();
+};
\ No newline at end of file
@@ -0,0 +1,516 @@
+#pragma once
+
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <exception>
+#include "thread_pool.h"
+#include "spin_barrier.h"
+
+
+//============================================================
+//	\namespace	parallel
+//
+//	\author	KeyC0de
+//	\date	18/10/2026
+//
+//	\brief	Data parallel algorithms executed on a given ThreadPool - or any BasicThreadPool
+//			The range is split into one contiguous chunk per worker; the calling thread
+//				runs the first chunk itself, then any chunk no worker has started yet, and
+//				blocks on the rest
+//			Do not call these from inside a task of the same pool - a blocked worker
+//				can no longer help and a fully blocked pool deadlocks
+//			Inner loops are plain indexed loops over random access iterators so the
+//				compiler is free to vectorize them
+//=============================================================
+namespace parallel
+{
+
+// ranges shorter than this are processed serially on the calling thread
+constexpr std::size_t g_grainSize = 4096;
+
+namespace detail
+{
+
+template<typename Pool>
+std::size_t chunkCount( Pool& pool,
+	std::size_t n ) noexcept
+{
+	const std::size_t nByGrain = ( n + g_grainSize - 1 ) / g_grainSize;
+	return std::max<std::size_t>( 1,
+		std::min( pool.workerCount(), nByGrain ) );
+}
+
+//===================================================
+//	\function	forEachChunk
+//	\brief  splits [0, n) into nChunks contiguous, independent slices and calls f( chunk, begin, end ) on each
+//			the calling thread runs the first slice, then every queued slice no worker has started yet
+//			should the pool refuse a slice, the queued ones not yet started are skipped instead
+//			rethrows the first exception thrown by any slice or by the pool - always after every
+//				slice started by a worker has finished, since they reference this stack frame
+//	\date	18/10/2026
+template<typename Pool, typename F>
+void forEachChunk( Pool& pool,
+	std::size_t n,
+	std::size_t nChunks,
+	F&& f )
+{
+	auto bounds = [n, nChunks] ( std::size_t c ) noexcept
+	{
+		return n * c / nChunks;
+	};
+
+	// a slice runs on whoever claims it first; queued tasks may outlive this frame, so the
+	//	flags are shared with them and f is only touched once a slice is claimed
+	auto claimed = std::make_shared<std::vector<std::atomic<bool>>>( nChunks );
+	auto claim = [&claimed] ( std::size_t c ) noexcept
+	{
+		return !( *claimed )[c].exchange( true,
+			std::memory_order_acq_rel );
+	};
+	std::vector<std::future<void>> futures;
+	futures.reserve( nChunks - 1 );
+	std::exception_ptr error;
+	try
+	{
+		for ( std::size_t c = 1; c < nChunks; ++c )
+		{
+			futures.emplace_back( pool.enqueue( [&f, claimed, c, b = bounds( c ), e = bounds( c + 1 )] ()
+			{
+				if ( !( *claimed )[c].exchange( true,
+					std::memory_order_acq_rel ) )
+				{
+					f( c, b, e );
+				}
+			} ) );
+		}
+		f( 0, bounds( 0 ), bounds( 1 ) );
+	}
+	catch ( ... )
+	{
+		error = std::current_exception();
+	}
+	// slices taken back from the queue - their tasks will find them claimed, if they ever run
+	std::vector<bool> bTakenBack( futures.size(), false );
+	for ( std::size_t c = 1; c <= futures.size(); ++c )
+	{
+		bTakenBack[c - 1] = claim( c );
+		if ( bTakenBack[c - 1] && !error )
+		{
+			try
+			{
+				f( c, bounds( c ), bounds( c + 1 ) );
+			}
+			catch ( ... )
+			{
+				error = std::current_exception();
+			}
+		}
+	}
+	for ( std::size_t c = 1; c <= futures.size(); ++c )
+	{
+		try
+		{
+			if ( !bTakenBack[c - 1] )
+			{
+				futures[c - 1].get();
+			}
+		}
+		catch ( ... )
+		{
+			if ( !error )
+			{
+				error = std::current_exception();
+			}
+		}
+	}
+	if ( error )
+	{
+		std::rethrow_exception( error );
+	}
+}
+
+}// namespace detail
+
+
+template<typename Pool, typename RandomIt, typename OutIt, typename UnaryOp>
+OutIt transform( Pool& pool,
+	RandomIt first,
+	RandomIt last,
+	OutIt out,
+	UnaryOp op )
+{
+	const std::size_t n = static_cast<std::size_t>( std::distance( first, last ) );
+	detail::forEachChunk( pool,
+		n,
+		detail::chunkCount( pool, n ),
+		[first, out, &op] ( std::size_t, std::size_t b, std::size_t e )
+		{
+			for ( std::size_t i = b; i < e; ++i )
+			{
+				out[i] = op( first[i] );
+			}
+		} );
+	return out + n;
+}
+
+template<typename Pool, typename RandomIt, typename UnaryPred>
+std::size_t countIf( Pool& pool,
+	RandomIt first,
+	RandomIt last,
+	UnaryPred pred )
+{
+	const std::size_t n = static_cast<std::size_t>( std::distance( first, last ) );
+	const std::size_t nChunks = detail::chunkCount( pool, n );
+	std::vector<std::size_t> counts( nChunks, 0 );
+	detail::forEachChunk( pool,
+		n,
+		nChunks,
+		[first, &pred, &counts] ( std::size_t c, std::size_t b, std::size_t e )
+		{
+			std::size_t count = 0;
+			for ( std::size_t i = b; i < e; ++i )
+			{
+				count += pred( first[i] ) ? 1 : 0;
+			}
+			counts[c] = count;
+		} );
+	std::size_t total = 0;
+	for ( std::size_t count : counts )
+	{
+		total += count;
+	}
+	return total;
+}
+
+//===================================================
+//	\function	findIf
+//	\brief  returns the first element satisfying pred, or last
+//			slices scan in blocks and give up once an earlier slice has found a match
+//	\date	18/10/2026
+template<typename Pool, typename RandomIt, typename UnaryPred>
+RandomIt findIf( Pool& pool,
+	RandomIt first,
+	RandomIt last,
+	UnaryPred pred )
+{
+	constexpr std::size_t blockSize = 1024;
+	const std::size_t n = static_cast<std::size_t>( std::distance( first, last ) );
+	std::atomic<std::size_t> found{n};
+	detail::forEachChunk( pool,
+		n,
+		detail::chunkCount( pool, n ),
+		[first, &pred, &found] ( std::size_t, std::size_t b, std::size_t e )
+		{
+			for ( std::size_t blockBegin = b; blockBegin < e; blockBegin += blockSize )
+			{
+				if ( found.load( std::memory_order_relaxed ) < blockBegin )
+				{
+					return;
+				}
+				const std::size_t blockEnd = std::min( blockBegin + blockSize, e );
+				for ( std::size_t i = blockBegin; i < blockEnd; ++i )
+				{
+					if ( pred( first[i] ) )
+					{
+						std::size_t prev = found.load( std::memory_order_relaxed );
+						while ( i < prev
+							&& !found.compare_exchange_weak( prev, i, std::memory_order_relaxed ) );
+						return;
+					}
+				}
+			}
+		} );
+	return first + found.load( std::memory_order_relaxed );
+}
+
+//===================================================
+//	\function	inclusiveScan
+//	\brief  out[i] = in[0] op ... op in[i]; op must be associative
+//			reduces each slice, scans the slice totals serially, then rescans each slice
+//				seeded with its offset
+//	\date	18/10/2026
+template<typename Pool, typename RandomIt, typename OutIt, typename BinaryOp = std::plus<>>
+OutIt inclusiveScan( Pool& pool,
+	RandomIt first,
+	RandomIt last,
+	OutIt out,
+	BinaryOp op = {} )
+{
+	using T = typename std::iterator_traits<RandomIt>::value_type;
+
+	const std::size_t n = static_cast<std::size_t>( std::distance( first, last ) );
+	if ( n == 0 )
+	{
+		return out;
+	}
+	const std::size_t nChunks = detail::chunkCount( pool, n );
+	std::vector<T> totals( nChunks );
+	detail::forEachChunk( pool,
+		n,
+		nChunks,
+		[first, &op, &totals] ( std::size_t c, std::size_t b, std::size_t e )
+		{
+			T acc = first[b];
+			for ( std::size_t i = b + 1; i < e; ++i )
+			{
+				acc = op( acc, first[i] );
+			}
+			totals[c] = acc;
+		} );
+	for ( std::size_t c = 1; c < nChunks; ++c )
+	{
+		totals[c] = op( totals[c - 1], totals[c] );
+	}
+	detail::forEachChunk( pool,
+		n,
+		nChunks,
+		[first, out, &op, &totals] ( std::size_t c, std::size_t b, std::size_t e )
+		{
+			T acc = c == 0 ? first[b] : op( totals[c - 1], first[b] );
+			out[b] = acc;
+			for ( std::size_t i = b + 1; i < e; ++i )
+			{
+				acc = op( acc, first[i] );
+				out[i] = acc;
+			}
+		} );
+	return out + n;
+}
+
+//===================================================
+//	\function	exclusiveScan
+//	\brief  out[i] = init op in[0] op ... op in[i - 1]; op must be associative
+//	\date	18/10/2026
+template<typename Pool, typename RandomIt, typename OutIt, typename T, typename BinaryOp = std::plus<>>
+OutIt exclusiveScan( Pool& pool,
+	RandomIt first,
+	RandomIt last,
+	OutIt out,
+	T init,
+	BinaryOp op = {} )
+{
+	const std::size_t n = static_cast<std::size_t>( std::distance( first, last ) );
+	if ( n == 0 )
+	{
+		return out;
+	}
+	const std::size_t nChunks = detail::chunkCount( pool, n );
+	std::vector<T> totals( nChunks );
+	detail::forEachChunk( pool,
+		n,
+		nChunks,
+		[first, &op, &totals] ( std::size_t c, std::size_t b, std::size_t e )
+		{
+			T acc = first[b];
+			for ( std::size_t i = b + 1; i < e; ++i )
+			{
+				acc = op( acc, first[i] );
+			}
+			totals[c] = acc;
+		} );
+	// totals[c] becomes the value carried into slice c
+	T carry = init;
+	for ( std::size_t c = 0; c < nChunks; ++c )
+	{
+		T next = op( carry, totals[c] );
+		totals[c] = carry;
+		carry = next;
+	}
+	detail::forEachChunk( pool,
+		n,
+		nChunks,
+		[first, out, &op, &totals] ( std::size_t c, std::size_t b, std::size_t e )
+		{
+			T acc = totals[c];
+			for ( std::size_t i = b; i < e; ++i )
+			{
+				T next = op( acc, first[i] );
+				out[i] = acc;
+				acc = next;
+			}
+		} );
+	return out + n;
+}
+
+//===================================================
+//	\function	sort
+//	\brief  parallel merge sort - slices are sorted concurrently then merged
+//				pairwise, each round of merges running concurrently
+//	\date	18/10/2026
+template<typename Pool, typename RandomIt, typename Compare = std::less<>>
+void sort( Pool& pool,
+	RandomIt first,
+	RandomIt last,
+	Compare comp = {} )
+{
+	using T = typename std::iterator_traits<RandomIt>::value_type;
+
+	const std::size_t n = static_cast<std::size_t>( std::distance( first, last ) );
+	const std::size_t nChunks = detail::chunkCount( pool, n );
+	std::vector<std::size_t> bounds( nChunks + 1 );
+	for ( std::size_t c = 0; c <= nChunks; ++c )
+	{
+		bounds[c] = n * c / nChunks;
+	}
+	detail::forEachChunk( pool,
+		n,
+		nChunks,
+		[first, &comp] ( std::size_t, std::size_t b, std::size_t e )
+		{
+			std::sort( first + b, first + e, comp );
+		} );
+	if ( nChunks == 1 )
+	{
+		return;
+	}
+
+	// ping-pong between the input range and a scratch buffer
+	std::vector<T> buffer( std::make_move_iterator( first ),
+		std::make_move_iterator( last ) );
+	bool bInBuffer = true;
+	for ( std::size_t width = 1; width < nChunks; width *= 2 )
+	{
+		const std::size_t nMerges = ( nChunks + 2 * width - 1 ) / ( 2 * width );
+		auto mergeOne = [&] ( std::size_t m )
+		{
+			const std::size_t lo = bounds[2 * width * m];
+			const std::size_t mid = bounds[std::min( 2 * width * m + width, nChunks )];
+			const std::size_t hi = bounds[std::min( 2 * width * m + 2 * width, nChunks )];
+			if ( bInBuffer )
+			{
+				std::merge( std::make_move_iterator( buffer.begin() + lo ),
+					std::make_move_iterator( buffer.begin() + mid ),
+					std::make_move_iterator( buffer.begin() + mid ),
+					std::make_move_iterator( buffer.begin() + hi ),
+					first + lo,
+					comp );
+			}
+			else
+			{
+				std::merge( std::make_move_iterator( first + lo ),
+					std::make_move_iterator( first + mid ),
+					std::make_move_iterator( first + mid ),
+					std::make_move_iterator( first + hi ),
+					buffer.begin() + lo,
+					comp );
+			}
+		};
+		detail::forEachChunk( pool,
+			nMerges,
+			nMerges,
+			[&mergeOne] ( std::size_t m, std::size_t, std::size_t )
+			{
+				mergeOne( m );
+			} );
+		bInBuffer = !bInBuffer;
+	}
+	if ( bInBuffer )
+	{
+		std::move( buffer.begin(),
+			buffer.end(),
+			first );
+	}
+}
+
+//===================================================
+//	\function	runPhases
+//	\brief  bulk synchronous execution: up to nWorkers participants each run
+//				phaseFn( participant, nParticipants, iteration ) then meet at a barrier,
+//				iterations times
+//			the participants - the calling thread & up to nWorkers - 1 pool workers - stay on the job
+//				for all iterations, so a phase costs no enqueue, allocation or future
+//			the workers are those parked at the call, each handed its participant directly, so two
+//				participants never queue behind one another; with fewer free workers - or cores,
+//				as every participant must be running at once - the job runs with fewer participants,
+//				down to the calling thread alone; split the work by the nParticipants passed on
+//			after a phase throws the remaining phases are skipped and the exception is rethrown
+//	\date	18/10/2026
+template<typename Pool, typename PhaseFn>
+void runPhases( Pool& pool,
+	std::size_t nWorkers,
+	PhaseFn&& phaseFn,
+	std::size_t iterations )
+{
+	const std::size_t nWanted = std::clamp<std::size_t>( nWorkers,
+		1,
+		std::max( std::thread::hardware_concurrency(), 1u ) );
+	// the barrier's first phase is a start gate, passed once we know how many workers were free
+	SpinBarrier barrier{nWanted};
+	std::size_t nParticipants = nWanted;	// set before the gate, read after it
+	std::atomic<bool> bFailed{false};
+	auto participate = [&phaseFn, &barrier, &bFailed, &nParticipants, iterations] ( std::size_t participant )
+	{
+		bool localSense = false;
+		barrier.arriveAndWait( localSense );
+		std::exception_ptr error;
+		for ( std::size_t it = 0; it < iterations; ++it )
+		{
+			if ( !bFailed.load( std::memory_order_relaxed ) )
+			{
+				try
+				{
+					phaseFn( participant,
+						nParticipants,
+						it );
+				}
+				catch ( ... )
+				{// keep arriving so nobody is left waiting at the barrier
+					error = std::current_exception();
+					bFailed.store( true,
+						std::memory_order_relaxed );
+				}
+			}
+			barrier.arriveAndWait( localSense );
+		}
+		if ( error )
+		{
+			std::rethrow_exception( error );
+		}
+	};
+
+	auto futures = pool.enqueueOnIdleWorkers( nWanted - 1,
+		[&participate] ( std::size_t i )
+		{
+			participate( i + 1 );
+		} );
+	nParticipants = futures.size() + 1;
+	for ( std::size_t n = nParticipants; n < nWanted; ++n )
+	{
+		barrier.arriveAndDrop();
+	}
+
+	std::exception_ptr error;
+	try
+	{
+		participate( 0 );
+	}
+	catch ( ... )
+	{
+		error = std::current_exception();
+	}
+	for ( auto& fu : futures )
+	{
+		try
+		{
+			fu.get();
+		}
+		catch ( ... )
+		{
+			if ( !error )
+			{
+				error = std::current_exception();
+			}
+		}
+	}
+	if ( error )
+	{
+		std::rethrow_exception( error );
+	}
+}
+
+}// namespace parallel
\ No newline at end of file
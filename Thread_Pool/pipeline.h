@@ -0,0 +1,363 @@
+#pragma once
+
+#include <map>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <atomic>
+#include <algorithm>
+#include "thread_pool.h"
+
+
+enum class StageMode
+{
+	SerialInOrder,		// one token at a time, in the order the source produced them
+	SerialOutOfOrder,	// one token at a time, in any order
+	Parallel			// any number of tokens concurrently
+};
+
+//============================================================
+//	\class	Pipeline
+//
+//	\author	KeyC0de
+//	\date	18/10/2026
+//
+//	\brief	A chain of stages through which tokens of type T flow, executed on ThreadPool workers
+//			A serial source fills tokens until it returns false; at most maxTokens are
+//				in flight at once so memory stays bounded no matter which stage is the bottleneck
+//			Tokens are recycled between runs - no allocation per item
+//			Should the pool refuse a task - eg. it was disabled - run() fails with its exception
+//=============================================================
+template<typename T, typename Pool = ThreadPool>
+class Pipeline final
+{
+public:
+	using Source = std::function<bool( T& )>;
+	using Filter = std::function<void( T& )>;
+private:
+	struct Token
+	{
+		T value{};
+		std::size_t seq = 0;
+	};
+
+	struct Stage
+	{
+		StageMode mode;
+		Filter fn;
+		std::mutex mu;
+		bool bBusy = false;							// a drain task is scheduled
+		std::size_t nextSeq = 0;					// next token allowed through an in-order stage
+		std::map<std::size_t, Token*> inOrder;
+		std::deque<Token*> outOfOrder;
+
+		Stage( StageMode m, Filter f )
+			:
+			mode{m},
+			fn{std::move( f )}
+		{
+
+		}
+	};
+
+	Pool& m_pool;
+	Source m_source;
+	std::vector<std::unique_ptr<Stage>> m_stages;
+	std::vector<std::unique_ptr<Token>> m_tokens;
+	std::mutex m_mu;
+	std::condition_variable m_cond;
+	std::vector<Token*> m_free;
+	std::size_t m_nextSeq = 0;
+	std::size_t m_nInFlight = 0;
+	std::size_t m_nTasks = 0;
+	bool m_bSourceBusy = false;
+	bool m_bSourceDone = true;
+	std::exception_ptr m_error;
+	std::atomic<bool> m_bFailed{false};
+public:
+	Pipeline( Pool& pool,
+		Source source )
+		:
+		m_pool{pool},
+		m_source{std::move( source )}
+	{
+
+	}
+
+	Pipeline( const Pipeline& ) = delete;
+	Pipeline& operator=( const Pipeline& ) = delete;
+
+	Pipeline& addStage( StageMode mode,
+		Filter fn )
+	{
+		m_stages.emplace_back( std::make_unique<Stage>( mode,
+			std::move( fn ) ) );
+		return *this;
+	}
+
+	//===================================================
+	//	\function	run
+	//	\brief  pushes every token the source produces through all stages
+	//			blocks until the last token retires; rethrows the first exception a stage threw
+	//	\date	18/10/2026
+	void run( std::size_t maxTokens )
+	{
+		maxTokens = std::max<std::size_t>( maxTokens, 1 );
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			while ( m_tokens.size() < maxTokens )
+			{
+				m_tokens.emplace_back( std::make_unique<Token>() );
+			}
+			m_free.clear();
+			for ( std::size_t i = 0; i < maxTokens; ++i )
+			{
+				m_free.push_back( m_tokens[i].get() );
+			}
+			m_nextSeq = 0;
+			m_bSourceDone = false;
+			m_error = nullptr;
+			m_bFailed.store( false,
+				std::memory_order_relaxed );
+		}
+		for ( auto& st : m_stages )
+		{
+			st->nextSeq = 0;
+		}
+
+		pump();
+
+		std::unique_lock<std::mutex> ul{m_mu};
+		m_cond.wait( ul,
+			[this] () { return isFinished(); } );
+		if ( m_error )
+		{
+			std::rethrow_exception( m_error );
+		}
+	}
+private:
+	// requires m_mu
+	bool isFinished() const noexcept
+	{
+		return m_bSourceDone && !m_bSourceBusy && m_nInFlight == 0 && m_nTasks == 0;
+	}
+
+	template<typename F>
+	void schedule( F&& f )
+	{
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			++m_nTasks;
+		}
+		auto task = [this, f = std::forward<F>( f )] () mutable
+		{
+			f();
+			std::lock_guard<std::mutex> lg{m_mu};
+			if ( --m_nTasks == 0 && isFinished() )
+			{
+				m_cond.notify_all();
+			}
+		};
+		try
+		{
+			m_pool.enqueue( task );
+		}
+		catch ( ... )
+		{// the pool refused: fail the run and take the step here - failed, it runs no user code
+			//	and only hands its token on, so the in flight counts still reach zero
+			fail( std::current_exception() );
+			task();
+		}
+	}
+
+	void fail( std::exception_ptr e )
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		if ( !m_error )
+		{
+			m_error = e;
+		}
+		m_bFailed.store( true,
+			std::memory_order_relaxed );
+		m_bSourceDone = true;
+	}
+
+	// starts the source if it is idle and a token is free
+	void pump()
+	{
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			if ( m_bSourceBusy || m_bSourceDone || m_free.empty() )
+			{
+				return;
+			}
+			m_bSourceBusy = true;
+		}
+		schedule( [this] () { produce(); } );
+	}
+
+	void produce()
+	{
+		while ( true )
+		{
+			Token* tok;
+			{
+				std::lock_guard<std::mutex> lg{m_mu};
+				if ( m_bSourceDone || m_free.empty() )
+				{
+					m_bSourceBusy = false;
+					return;
+				}
+				tok = m_free.back();
+				m_free.pop_back();
+				tok->seq = m_nextSeq;
+				++m_nInFlight;
+			}
+
+			bool bMore = false;
+			try
+			{
+				bMore = m_source( tok->value );
+			}
+			catch ( ... )
+			{
+				fail( std::current_exception() );
+			}
+
+			{
+				std::lock_guard<std::mutex> lg{m_mu};
+				if ( !bMore )
+				{
+					m_free.push_back( tok );
+					--m_nInFlight;
+					m_bSourceDone = true;
+					m_bSourceBusy = false;
+					return;
+				}
+				++m_nextSeq;
+			}
+			forward( tok, 0 );
+		}
+	}
+
+	// hands the token to stage si, or retires it past the last stage
+	void forward( Token* tok,
+		std::size_t si )
+	{
+		if ( si == m_stages.size() )
+		{
+			retire( tok );
+			return;
+		}
+
+		Stage& st = *m_stages[si];
+		if ( st.mode == StageMode::Parallel )
+		{
+			schedule( [this, tok, si] () { process( tok, si ); } );
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lg{st.mu};
+			if ( st.mode == StageMode::SerialInOrder )
+			{
+				st.inOrder.emplace( tok->seq,
+					tok );
+			}
+			else
+			{
+				st.outOfOrder.push_back( tok );
+			}
+			if ( st.bBusy || !isReady( st ) )
+			{
+				return;
+			}
+			st.bBusy = true;
+		}
+		schedule( [this, si] () { drain( si ); } );
+	}
+
+	// runs a parallel stage and any parallel stages directly after it on the same worker
+	void process( Token* tok,
+		std::size_t si )
+	{
+		while ( si < m_stages.size() && m_stages[si]->mode == StageMode::Parallel )
+		{
+			invoke( *m_stages[si], tok );
+			++si;
+		}
+		forward( tok, si );
+	}
+
+	// a serial stage's single consumer; keeps going while tokens are ready
+	void drain( std::size_t si )
+	{
+		Stage& st = *m_stages[si];
+		while ( true )
+		{
+			Token* tok;
+			{
+				std::lock_guard<std::mutex> lg{st.mu};
+				if ( !isReady( st ) )
+				{
+					st.bBusy = false;
+					return;
+				}
+				if ( st.mode == StageMode::SerialInOrder )
+				{
+					tok = st.inOrder.begin()->second;
+					st.inOrder.erase( st.inOrder.begin() );
+					++st.nextSeq;
+				}
+				else
+				{
+					tok = st.outOfOrder.front();
+					st.outOfOrder.pop_front();
+				}
+			}
+			invoke( st, tok );
+			forward( tok, si + 1 );
+		}
+	}
+
+	// requires st.mu
+	static bool isReady( const Stage& st ) noexcept
+	{
+		if ( st.mode == StageMode::SerialInOrder )
+		{
+			return !st.inOrder.empty() && st.inOrder.begin()->first == st.nextSeq;
+		}
+		return !st.outOfOrder.empty();
+	}
+
+	void invoke( Stage& st,
+		Token* tok )
+	{
+		if ( m_bFailed.load( std::memory_order_relaxed ) )
+		{// drain remaining tokens without running user code
+			return;
+		}
+		try
+		{
+			st.fn( tok->value );
+		}
+		catch ( ... )
+		{
+			fail( std::current_exception() );
+		}
+	}
+
+	void retire( Token* tok )
+	{
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			m_free.push_back( tok );
+			--m_nInFlight;
+		}
+		pump();
+	}
+};
\ No newline at end of file
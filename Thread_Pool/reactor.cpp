@@ -0,0 +1,213 @@
+#if defined __linux__
+
+#include <vector>
+#include <cerrno>
+#include <system_error>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "reactor.h"
+
+
+Reactor::Reactor( ThreadPool& pool,
+	std::size_t maxEvents )
+	:
+	m_pool{pool},
+	m_epfd{epoll_create1( EPOLL_CLOEXEC )},
+	m_wakeFd{eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC )},
+	m_maxEvents{maxEvents == 0 ? 1 : maxEvents},
+	m_nInFlight{0},
+	m_bStop{false}
+{
+	if ( m_epfd < 0 || m_wakeFd < 0 )
+	{
+		const int err = errno;
+		if ( m_epfd >= 0 )
+		{
+			close( m_epfd );
+		}
+		if ( m_wakeFd >= 0 )
+		{
+			close( m_wakeFd );
+		}
+		throw std::system_error{err, std::generic_category(), "Reactor setup failed"};
+	}
+	epoll_event ev{};
+	ev.events = EPOLLIN;
+	ev.data.fd = m_wakeFd;
+	epoll_ctl( m_epfd,
+		EPOLL_CTL_ADD,
+		m_wakeFd,
+		&ev );
+}
+
+Reactor::~Reactor() noexcept
+{
+	stop();
+	close( m_wakeFd );
+	close( m_epfd );
+}
+
+void Reactor::start()
+{
+	if ( !m_thread.joinable() )
+	{
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			m_bStop = false;
+		}
+		m_thread = std::thread{&Reactor::loop, this};
+	}
+}
+
+void Reactor::stop() noexcept
+{
+	if ( m_thread.joinable() )
+	{
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			m_bStop = true;
+		}
+		const std::uint64_t one = 1;
+		[[maybe_unused]] const ssize_t n = write( m_wakeFd,
+			&one,
+			sizeof one );
+		m_thread.join();
+	}
+	std::unique_lock<std::mutex> ul{m_mu};
+	m_cond.wait( ul,
+		[this] () { return m_nInFlight == 0; } );
+}
+
+void Reactor::add( int fd,
+	std::uint32_t events,
+	Handler handler )
+{
+	auto reg = std::make_shared<Registration>( Registration{events, std::move( handler )} );
+	std::lock_guard<std::mutex> lg{m_mu};
+	epoll_event ev{};
+	ev.events = events | EPOLLET | EPOLLONESHOT;
+	ev.data.fd = fd;
+	if ( epoll_ctl( m_epfd, EPOLL_CTL_ADD, fd, &ev ) != 0 )
+	{
+		throw std::system_error{errno, std::generic_category(), "epoll_ctl ADD failed"};
+	}
+	m_registrations[fd] = std::move( reg );
+}
+
+void Reactor::remove( int fd )
+{
+	std::lock_guard<std::mutex> lg{m_mu};
+	if ( m_registrations.erase( fd ) != 0 )
+	{
+		epoll_ctl( m_epfd,
+			EPOLL_CTL_DEL,
+			fd,
+			nullptr );
+	}
+}
+
+void Reactor::loop()
+{
+	std::vector<epoll_event> events( m_maxEvents );
+	while ( true )
+	{
+		const int n = epoll_wait( m_epfd,
+			events.data(),
+			static_cast<int>( events.size() ),
+			-1 );
+		if ( n < 0 )
+		{
+			if ( errno == EINTR )
+			{
+				continue;
+			}
+			break;
+		}
+
+		// the whole batch is dispatched before waiting again
+		for ( int i = 0; i < n; ++i )
+		{
+			if ( events[i].data.fd == m_wakeFd )
+			{
+				std::uint64_t count;
+				[[maybe_unused]] const ssize_t r = read( m_wakeFd,
+					&count,
+					sizeof count );
+				continue;
+			}
+			dispatch( events[i].data.fd,
+				events[i].events );
+		}
+
+		std::lock_guard<std::mutex> lg{m_mu};
+		if ( m_bStop )
+		{
+			break;
+		}
+	}
+}
+
+void Reactor::dispatch( int fd,
+	std::uint32_t events )
+{
+	std::shared_ptr<Registration> reg;
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		auto it = m_registrations.find( fd );
+		if ( it == m_registrations.end() )
+		{
+			return;
+		}
+		reg = it->second;
+		++m_nInFlight;
+	}
+
+	auto finish = [this] ()
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		if ( --m_nInFlight == 0 )
+		{
+			m_cond.notify_all();
+		}
+	};
+
+	try
+	{
+		m_pool.enqueue( [this, fd, events, reg, finish] ()
+		{
+			try
+			{
+				reg->handler( fd, events );
+			}
+			catch ( ... )
+			{// keep serving the fd; the handler owns its errors
+			}
+			rearm( fd, reg );
+			finish();
+		} );
+	}
+	catch ( ... )
+	{// pool is disabled - the event is dropped and the fd stays disarmed
+		finish();
+	}
+}
+
+void Reactor::rearm( int fd,
+	const std::shared_ptr<Registration>& reg )
+{
+	std::lock_guard<std::mutex> lg{m_mu};
+	auto it = m_registrations.find( fd );
+	if ( it == m_registrations.end() || it->second != reg )
+	{// removed, or the fd was closed and registered anew
+		return;
+	}
+	epoll_event ev{};
+	ev.events = reg->events | EPOLLET | EPOLLONESHOT;
+	ev.data.fd = fd;
+	epoll_ctl( m_epfd,
+		EPOLL_CTL_MOD,
+		fd,
+		&ev );
+}
+
+#endif // __linux__
\ No newline at end of file
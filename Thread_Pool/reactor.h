@@ -0,0 +1,80 @@
+#pragma once
+
+#if defined __linux__
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+#include <sys/epoll.h>
+#include "thread_pool.h"
+
+
+//============================================================
+//	\class	Reactor
+//
+//	\author	KeyC0de
+//	\date	18/10/2026
+//
+//	\brief	An epoll based readiness loop which dispatches handlers onto a ThreadPool
+//			File descriptors (sockets, pipes, eventfd ..) are registered edge-triggered and
+//				one-shot: once an fd fires it is disarmed, its handler runs as a pool task
+//				and the fd is re-armed when the handler returns - so a handler never runs
+//				concurrently with itself and a few workers can serve thousands of fds
+//			Handlers must drain the fd until EAGAIN since events are edge-triggered
+//			Linux only
+//=============================================================
+class Reactor final
+{
+public:
+	using Handler = std::function<void( int fd, std::uint32_t events )>;
+private:
+	struct Registration
+	{
+		std::uint32_t events;
+		Handler handler;
+	};
+
+	ThreadPool& m_pool;
+	int m_epfd;
+	int m_wakeFd;				// eventfd used to interrupt epoll_wait on stop
+	std::size_t m_maxEvents;	// readiness events dispatched per epoll_wait
+	std::thread m_thread;
+	std::mutex m_mu;
+	std::condition_variable m_cond;
+	std::unordered_map<int, std::shared_ptr<Registration>> m_registrations;
+	std::size_t m_nInFlight;	// handler tasks queued or running
+	bool m_bStop;
+public:
+	explicit Reactor( ThreadPool& pool, std::size_t maxEvents = 64 );
+	~Reactor() noexcept;
+	Reactor( const Reactor& ) = delete;
+	Reactor& operator=( const Reactor& ) = delete;
+
+	void start();
+	//===================================================
+	//	\function	stop
+	//	\brief  ends the event loop and waits for dispatched handlers to finish
+	//	\date	18/10/2026
+	void stop() noexcept;
+	//===================================================
+	//	\function	add
+	//	\brief  registers fd for events (EPOLLIN, EPOLLOUT ..); EPOLLET | EPOLLONESHOT are implied
+	//	\date	18/10/2026
+	void add( int fd, std::uint32_t events, Handler handler );
+	//===================================================
+	//	\function	remove
+	//	\brief  deregisters fd; a handler already dispatched still runs once
+	//			safe to call from within the fd's own handler
+	//	\date	18/10/2026
+	void remove( int fd );
+private:
+	void loop();
+	void dispatch( int fd, std::uint32_t events );
+	void rearm( int fd, const std::shared_ptr<Registration>& reg );
+};
+
+#endif // __linux__
\ No newline at end of file
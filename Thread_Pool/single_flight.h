@@ -0,0 +1,196 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <chrono>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <unordered_map>
+#include "thread_pool.h"
+
+
+//============================================================
+//	\class	SingleFlight
+//
+//	\author	KeyC0de
+//	\date	18/10/2026
+//
+//	\brief	Deduplicates idempotent tasks of a given ThreadPool - or any BasicThreadPool - by key
+//			While a task of some key is queued or running, enqueueOnce with the same key
+//				shares its future instead of queueing a duplicate
+//			Optionally keeps the results of up to capacity recent keys for ttl, evicting the
+//				least recently used; failed tasks are never cached
+//			Must outlive the tasks it queued
+//=============================================================
+template<typename Key, typename Value, typename Pool = ThreadPool, typename Hash = std::hash<Key>>
+class SingleFlight final
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry
+	{
+		std::shared_future<Value> result;
+		Clock::time_point expiry;
+		typename std::list<Key>::iterator lru;
+	};
+
+	Pool& m_pool;
+	std::size_t m_capacity;
+	Clock::duration m_ttl;
+	std::mutex m_mu;
+	std::unordered_map<Key, std::shared_future<Value>, Hash> m_inFlight;
+	std::unordered_map<Key, Entry, Hash> m_cache;
+	std::list<Key> m_lru;			// most recently used first
+	std::atomic<std::size_t> m_nExecuted{0};
+	std::atomic<std::size_t> m_nShared{0};
+	std::atomic<std::size_t> m_nCacheHits{0};
+public:
+	struct Stats
+	{
+		std::size_t nExecuted;		// tasks actually queued
+		std::size_t nShared;		// calls that joined a queued or running task
+		std::size_t nCacheHits;		// calls answered from the result cache
+	};
+
+	//===================================================
+	//	\function	SingleFlight
+	//	\brief  capacity 0 disables the result cache; results are deduplicated only while in flight
+	//	\date	18/10/2026
+	explicit SingleFlight( Pool& pool,
+		std::size_t capacity = 0,
+		Clock::duration ttl = std::chrono::seconds{1} )
+		:
+		m_pool{pool},
+		m_capacity{capacity},
+		m_ttl{ttl}
+	{
+
+	}
+
+	SingleFlight( const SingleFlight& ) = delete;
+	SingleFlight& operator=( const SingleFlight& ) = delete;
+
+	//===================================================
+	//	\function	enqueueOnce
+	//	\brief  returns the cached result of key, else the future of the task already in flight
+	//				for key, else queues f() on the pool as that task
+	//	\date	18/10/2026
+	template<typename Callback>
+	std::shared_future<Value> enqueueOnce( const Key& key,
+		Callback&& f )
+	{
+		std::shared_ptr<std::promise<Value>> promise;
+		std::shared_future<Value> result;
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			auto cached = m_cache.find( key );
+			if ( cached != m_cache.end() )
+			{
+				if ( Clock::now() < cached->second.expiry )
+				{
+					m_lru.splice( m_lru.begin(),
+						m_lru,
+						cached->second.lru );
+					m_nCacheHits.fetch_add( 1,
+						std::memory_order_relaxed );
+					return cached->second.result;
+				}
+				m_lru.erase( cached->second.lru );
+				m_cache.erase( cached );
+			}
+			auto running = m_inFlight.find( key );
+			if ( running != m_inFlight.end() )
+			{
+				m_nShared.fetch_add( 1,
+					std::memory_order_relaxed );
+				return running->second;
+			}
+			promise = std::make_shared<std::promise<Value>>();
+			result = promise->get_future().share();
+			m_inFlight.emplace( key,
+				result );
+		}
+
+		try
+		{
+			m_pool.enqueue( [this, key, promise, f = std::forward<Callback>( f )] () mutable
+			{
+				try
+				{
+					Value value = f();
+					complete( key,
+						true );
+					promise->set_value( std::move( value ) );
+				}
+				catch ( ... )
+				{
+					complete( key,
+						false );
+					promise->set_exception( std::current_exception() );
+				}
+			} );
+		}
+		catch ( ... )
+		{// the pool is disabled - nobody will complete key
+			complete( key,
+				false );
+			throw;
+		}
+		m_nExecuted.fetch_add( 1,
+			std::memory_order_relaxed );
+		return result;
+	}
+
+	// drops the cached result of key; a task in flight is not affected
+	void invalidate( const Key& key )
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		auto cached = m_cache.find( key );
+		if ( cached != m_cache.end() )
+		{
+			m_lru.erase( cached->second.lru );
+			m_cache.erase( cached );
+		}
+	}
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		m_cache.clear();
+		m_lru.clear();
+	}
+
+	Stats stats() const noexcept
+	{
+		return Stats{m_nExecuted.load( std::memory_order_relaxed ),
+			m_nShared.load( std::memory_order_relaxed ),
+			m_nCacheHits.load( std::memory_order_relaxed )};
+	}
+private:
+	// retires key's task; a successful result moves into the cache
+	void complete( const Key& key,
+		bool bSucceeded )
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		auto running = m_inFlight.find( key );
+		if ( running == m_inFlight.end() )
+		{
+			return;
+		}
+		if ( bSucceeded && m_capacity > 0 )
+		{
+			if ( m_cache.size() >= m_capacity )
+			{
+				m_cache.erase( m_lru.back() );
+				m_lru.pop_back();
+			}
+			m_lru.push_front( key );
+			m_cache.emplace( key,
+				Entry{std::move( running->second ), Clock::now() + m_ttl, m_lru.begin()} );
+		}
+		m_inFlight.erase( running );
+	}
+};
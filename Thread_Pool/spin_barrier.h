@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#if defined _M_X64 || defined _M_IX86 || defined __x86_64__ || defined __i386__
+#	include <immintrin.h>
+#	define CPU_RELAX() _mm_pause()
+#else
+#	define CPU_RELAX() void(0)
+#endif
+
+
+//============================================================
+//	\class	SpinBarrier
+//
+//	\author	KeyC0de
+//	\date	18/10/2026
+//
+//	\brief	A reusable sense-reversing barrier for a number of participants set up front;
+//				a participant may drop out for good with arriveAndDrop
+//			The last to arrive resets the count and flips the shared sense; everyone else
+//				spins until the sense matches their own, so the barrier can be reused right
+//				away without a second phase to reset it
+//			Spins for sub-microsecond handoff then yields, so it is only for participants
+//				that all have a core - eg. workers of a pool that are on the same job
+//=============================================================
+class SpinBarrier final
+{
+	alignas( 64 ) std::atomic<std::size_t> m_nRemaining;
+	alignas( 64 ) std::atomic<bool> m_sense;
+	std::atomic<std::size_t> m_nParticipants;	// lowered by arriveAndDrop
+public:
+	explicit SpinBarrier( std::size_t nParticipants ) noexcept
+		:
+		m_nRemaining{nParticipants},
+		m_sense{false},
+		m_nParticipants{nParticipants}
+	{
+
+	}
+
+	SpinBarrier( const SpinBarrier& ) = delete;
+	SpinBarrier& operator=( const SpinBarrier& ) = delete;
+
+	//===================================================
+	//	\function	arriveAndWait
+	//	\brief  blocks until every participant has arrived
+	//			localSense belongs to the calling participant; start it false and pass it every time
+	//	\date	18/10/2026
+	void arriveAndWait( bool& localSense ) noexcept
+	{
+		constexpr unsigned nSpins = 256;
+
+		localSense = !localSense;
+		if ( m_nRemaining.fetch_sub( 1,
+			std::memory_order_acq_rel ) == 1 )
+		{
+			m_nRemaining.store( m_nParticipants.load( std::memory_order_relaxed ),
+				std::memory_order_relaxed );
+			m_sense.store( localSense,
+				std::memory_order_release );
+			return;
+		}
+		unsigned spins = 0;
+		while ( m_sense.load( std::memory_order_acquire ) != localSense )
+		{
+			if ( ++spins < nSpins )
+			{
+				CPU_RELAX();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+	//===================================================
+	//	\function	arriveAndDrop
+	//	\brief  arrives at the current phase without waiting & leaves the barrier for good,
+	//				so later phases expect one participant less
+	//	\date	18/10/2026
+	void arriveAndDrop() noexcept
+	{
+		// lowered before arriving, so whoever arrives last - & resets the count - sees it
+		m_nParticipants.fetch_sub( 1,
+			std::memory_order_relaxed );
+		if ( m_nRemaining.fetch_sub( 1,
+			std::memory_order_acq_rel ) == 1 )
+		{
+			m_nRemaining.store( m_nParticipants.load( std::memory_order_relaxed ),
+				std::memory_order_relaxed );
+			m_sense.store( !m_sense.load( std::memory_order_relaxed ),
+				std::memory_order_release );
+		}
+	}
+};
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <queue>
+#include <stack>
+#include <vector>
+#include <tuple>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <future>
+#include <thread>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+
+//============================================================
+//	\file	thread_pool_policies.h
+//
+//	\author	KeyC0de
+//	\date	18/10/2026
+//
+//	\brief	Compile time building blocks of BasicThreadPool
+//			QueuePolicy<Task>	the shared task queue; every call is made with the pool's mutex held
+//									void push( Task&& ); bool pop( Task& ); std::size_t size() const; bool empty() const
+//			IdlePolicy			how a worker with nothing to do waits to be woken
+//									template<class Pred> static void park( std::condition_variable&, std::unique_lock<std::mutex>&,
+//										const std::atomic<bool>& bSignaled, Pred bDone )
+//									bDone must be called with the lock held; bSignaled is raised, under the lock, whenever
+//										bDone may have become true and may be polled without it
+//			TaskPolicy			how callables are stored and tied to their std::future
+//									using Task; template<class F, class... Args> static std::future<R> make( Task&, F&&, Args&&... )
+//=============================================================
+
+
+//============================================================
+//	Queue policies
+//=============================================================
+
+// first come first served
+template<typename Task>
+class FifoQueue final
+{
+	std::queue<Task> m_tasks;
+public:
+	void push( Task&& task )
+	{
+		m_tasks.emplace( std::move( task ) );
+	}
+
+	bool pop( Task& task )
+	{
+		if ( m_tasks.empty() )
+		{
+			return false;
+		}
+		task = std::move( m_tasks.front() );
+		m_tasks.pop();
+		return true;
+	}
+
+	std::size_t size() const noexcept
+	{
+		return m_tasks.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return m_tasks.empty();
+	}
+};
+
+// newest first - the task just queued is the one whose data is still in cache
+//	suits recursive divide & conquer work; offers no fairness
+template<typename Task>
+class LifoQueue final
+{
+	std::stack<Task, std::vector<Task>> m_tasks;
+public:
+	void push( Task&& task )
+	{
+		m_tasks.emplace( std::move( task ) );
+	}
+
+	bool pop( Task& task )
+	{
+		if ( m_tasks.empty() )
+		{
+			return false;
+		}
+		task = std::move( m_tasks.top() );
+		m_tasks.pop();
+		return true;
+	}
+
+	std::size_t size() const noexcept
+	{
+		return m_tasks.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return m_tasks.empty();
+	}
+};
+
+
+//============================================================
+//	Idle policies
+//=============================================================
+
+// sleep on the worker's condition variable straight away
+struct BlockingIdle final
+{
+	template<typename Pred>
+	static void park( std::condition_variable& cond,
+		std::unique_lock<std::mutex>& ul,
+		const std::atomic<bool>&,
+		Pred bDone )
+	{
+		if ( !bDone() )
+		{
+			cond.wait( ul );
+		}
+	}
+};
+
+// poll the wake up signal up to nSpins times, yielding in between, before sleeping
+//	trades cpu for wake up latency on bursty micro tasks; the pool's lock is released while spinning
+template<std::size_t nSpins = 64>
+struct SpinningIdle final
+{
+	template<typename Pred>
+	static void park( std::condition_variable& cond,
+		std::unique_lock<std::mutex>& ul,
+		const std::atomic<bool>& bSignaled,
+		Pred bDone )
+	{
+		ul.unlock();
+		for ( std::size_t i = 0; i < nSpins && !bSignaled.load( std::memory_order_acquire ); ++i )
+		{
+			std::this_thread::yield();
+		}
+		ul.lock();
+		if ( !bDone() )
+		{
+			cond.wait( ul );
+		}
+	}
+};
+
+
+//============================================================
+//	Task policies
+//=============================================================
+
+// copyable std::function holding a shared std::packaged_task
+struct FunctionTask final
+{
+	using Task = std::function<void()>;
+
+	template<typename Callback, typename... TArgs>
+	static auto make( Task& task,
+		Callback&& f,
+		TArgs&&... args )
+	{
+		using ReturnType = std::invoke_result_t<Callback, TArgs...>;
+		using FuncType = ReturnType(TArgs...);
+		using Wrapped = std::packaged_task<FuncType>;
+
+		std::shared_ptr<Wrapped> smartFunctionPointer =
+			std::make_shared<Wrapped>( std::forward<Callback>( f ) );
+		std::future<ReturnType> fu = smartFunctionPointer->get_future();
+
+		task = [smartFunctionPointer = std::move( smartFunctionPointer ),
+				args = std::make_tuple( std::forward<TArgs>( args )... )] () -> void
+		{
+			std::apply( *smartFunctionPointer,
+				std::move( args ) );
+			return;
+		};
+		return fu;
+	}
+};
+
+//============================================================
+//	\class	UniqueFunction
+//
+//	\brief	move only void() callable - unlike std::function it can own a std::packaged_task
+//				directly, saving the shared_ptr indirection & its allocation
+//=============================================================
+class UniqueFunction final
+{
+	struct Concept
+	{
+		virtual ~Concept() noexcept = default;
+		virtual void run() = 0;
+	};
+
+	template<typename F>
+	struct Model final
+		: Concept
+	{
+		F f;
+
+		template<typename G>
+		explicit Model( G&& fn )
+			:
+			f{std::forward<G>( fn )}
+		{
+
+		}
+
+		void run() override
+		{
+			f();
+		}
+	};
+
+	std::unique_ptr<Concept> m_p;
+public:
+	UniqueFunction() noexcept = default;
+
+	template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, UniqueFunction>>>
+	UniqueFunction( F&& f )
+		:
+		m_p{std::make_unique<Model<std::decay_t<F>>>( std::forward<F>( f ) )}
+	{
+
+	}
+
+	UniqueFunction( UniqueFunction&& ) noexcept = default;
+	UniqueFunction& operator=( UniqueFunction&& ) noexcept = default;
+
+	void operator()()
+	{
+		m_p->run();
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return m_p != nullptr;
+	}
+};
+
+// move only task owning its std::packaged_task
+struct UniqueTask final
+{
+	using Task = UniqueFunction;
+
+	template<typename Callback, typename... TArgs>
+	static auto make( Task& task,
+		Callback&& f,
+		TArgs&&... args )
+	{
+		using ReturnType = std::invoke_result_t<Callback, TArgs...>;
+
+		std::packaged_task<ReturnType()> wrapped{
+			[f = std::forward<Callback>( f ),
+				args = std::make_tuple( std::forward<TArgs>( args )... )] () mutable -> ReturnType
+			{
+				return std::apply( f,
+					std::move( args ) );
+			}};
+		std::future<ReturnType> fu = wrapped.get_future();
+		task = UniqueFunction{std::move( wrapped )};
+		return fu;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include "thread_pool.h"
+
+
+//============================================================
+//	\class	WorkerLocal
+//
+//	\author	KeyC0de
+//	\date	18/10/2026
+//
+//	\brief	One instance of T per worker of a given ThreadPool - or any BasicThreadPool
+//			Tasks reuse their worker's scratch buffers, RNGs or partial results through
+//				local() without allocating or locking; combine() folds them afterwards
+//			Unlike thread_local the storage belongs to one pool and one container, so
+//				separate pools and separate containers never see each other's state
+//			Each instance sits on its own cache line to avoid false sharing
+//=============================================================
+template<typename T, typename Pool = ThreadPool>
+class WorkerLocal final
+{
+	struct alignas( 64 ) Slot
+	{
+		T value;
+	};
+
+	const Pool& m_pool;
+	std::vector<Slot> m_slots;
+public:
+	explicit WorkerLocal( const Pool& pool,
+		const T& init = T{} )
+		:
+		m_pool{pool},
+		m_slots( pool.workerCount(), Slot{init} )
+	{
+
+	}
+
+	WorkerLocal( const WorkerLocal& ) = delete;
+	WorkerLocal& operator=( const WorkerLocal& ) = delete;
+
+	//===================================================
+	//	\function	local
+	//	\brief  the calling worker's instance
+	//			must be called from a task running on the pool
+	//	\date	18/10/2026
+	T& local()
+	{
+		const std::size_t wi = m_pool.workerIndex();
+		if ( wi == Pool::npos )
+		{
+			throw std::logic_error{"WorkerLocal::local() called outside of its ThreadPool"};
+		}
+		return m_slots[wi].value;
+	}
+
+	template<typename F>
+	void forEach( F&& f )
+	{
+		for ( auto& slot : m_slots )
+		{
+			f( slot.value );
+		}
+	}
+
+	//===================================================
+	//	\function	combine
+	//	\brief  folds every worker's instance into init with op
+	//			call once the tasks using local() have finished
+	//	\date	18/10/2026
+	template<typename BinaryOp>
+	T combine( T init,
+		BinaryOp op ) const
+	{
+		for ( const auto& slot : m_slots )
+		{
+			init = op( std::move( init ), slot.value );
+		}
+		return init;
+	}
+};
\ No newline at end of file
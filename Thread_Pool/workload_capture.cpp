@@ -0,0 +1,130 @@
+#include <atomic>
+#include <cstring>
+#include <system_error>
+#include "workload_capture.h"
+
+
+namespace
+{
+
+constexpr char g_magic[4] = {'T', 'P', 'W', 'L'};
+constexpr std::size_t g_blockSize = 4096;	// records buffered before a write
+
+std::uint64_t toNs( WorkloadRecorder::Clock::duration d ) noexcept
+{
+	const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>( d ).count();
+	return ns > 0 ? static_cast<std::uint64_t>( ns ) : 0;
+}
+
+}// namespace
+
+
+WorkloadRecorder::WorkloadRecorder( const std::string& path )
+	:
+	m_file{path, std::ios::binary | std::ios::trunc},
+	m_origin{Clock::now()}
+{
+	if ( !m_file )
+	{
+		throw std::system_error{std::make_error_code( std::errc::io_error ), "cannot open " + path};
+	}
+	m_file.write( g_magic, sizeof g_magic );
+	m_file.write( reinterpret_cast<const char*>( &version ), sizeof version );
+	m_buffer.reserve( g_blockSize );
+}
+
+WorkloadRecorder::~WorkloadRecorder() noexcept
+{
+	try
+	{
+		write( m_buffer );
+	}
+	catch ( ... )
+	{
+
+	}
+}
+
+void WorkloadRecorder::record( Clock::time_point enqueued,
+	Clock::time_point started,
+	Clock::time_point finished,
+	std::uint32_t producer ) noexcept
+{
+	const WorkloadRecord r{toNs( enqueued - m_origin ),
+		toNs( started - enqueued ),
+		toNs( finished - started ),
+		producer,
+		0};
+	try
+	{
+		std::vector<WorkloadRecord> full;
+		{
+			std::lock_guard<std::mutex> lg{m_mu};
+			m_buffer.push_back( r );
+			if ( m_buffer.size() < g_blockSize )
+			{
+				return;
+			}
+			full.reserve( g_blockSize );
+			full.swap( m_buffer );
+		}
+		write( full );
+	}
+	catch ( ... )
+	{
+
+	}
+}
+
+void WorkloadRecorder::flush()
+{
+	std::vector<WorkloadRecord> pending;
+	{
+		std::lock_guard<std::mutex> lg{m_mu};
+		pending.swap( m_buffer );
+	}
+	write( pending );
+}
+
+std::uint32_t WorkloadRecorder::threadOrdinal() noexcept
+{
+	static std::atomic<std::uint32_t> nThreads{0};
+	static thread_local const std::uint32_t ordinal = nThreads.fetch_add( 1,
+		std::memory_order_relaxed );
+	return ordinal;
+}
+
+void WorkloadRecorder::write( const std::vector<WorkloadRecord>& records )
+{
+	std::lock_guard<std::mutex> lg{m_fileMu};
+	m_file.write( reinterpret_cast<const char*>( records.data() ),
+		records.size() * sizeof( WorkloadRecord ) );
+	m_file.flush();
+}
+
+std::vector<WorkloadRecord> loadWorkload( const std::string& path )
+{
+	std::ifstream file{path, std::ios::binary};
+	char magic[sizeof g_magic];
+	std::uint32_t fileVersion = 0;
+	file.read( magic, sizeof magic );
+	file.read( reinterpret_cast<char*>( &fileVersion ), sizeof fileVersion );
+	if ( !file || std::memcmp( magic, g_magic, sizeof magic ) != 0 || fileVersion != WorkloadRecorder::version )
+	{
+		throw std::system_error{std::make_error_code( std::errc::invalid_argument ), path + " is not a workload capture"};
+	}
+
+	std::vector<WorkloadRecord> records;
+	WorkloadRecord r;
+	while ( file.read( reinterpret_cast<char*>( &r ), sizeof r ) )
+	{
+		records.push_back( r );
+	}
+	std::sort( records.begin(),
+		records.end(),
+		[] ( const WorkloadRecord& a, const WorkloadRecord& b )
+		{
+			return a.enqueueNs < b.enqueueNs;
+		} );
+	return records;
+}
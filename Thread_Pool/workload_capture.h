@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <future>
+#include <fstream>
+#include <algorithm>
+
+
+//============================================================
+//	\struct	WorkloadRecord
+//
+//	\brief	one task as seen by a recording ThreadPool; all times in nanoseconds
+//			written as is, so a capture is read back on a machine of the same endianness
+//=============================================================
+struct WorkloadRecord
+{
+	std::uint64_t enqueueNs;	// since recording started
+	std::uint64_t waitNs;		// enqueue until a worker picked the task up
+	std::uint64_t execNs;
+	std::uint32_t producer;		// ordinal of the submitting thread
+	std::uint32_t reserved;
+};
+
+static_assert( sizeof( WorkloadRecord ) == 32, "WorkloadRecord is written to disk as is" );
+
+//============================================================
+//	\class	WorkloadRecorder
+//
+//	\author	KeyC0de
+//	\date	18/10/2026
+//
+//	\brief	Appends WorkloadRecords to a binary capture file - see BasicThreadPool::startRecording
+//			File layout: "TPWL", uint32 version, then the records in completion order
+//			Records are buffered and written in blocks & on flush; a task is recorded before
+//				its future becomes ready
+//=============================================================
+class WorkloadRecorder final
+{
+public:
+	using Clock = std::chrono::steady_clock;
+	static constexpr std::uint32_t version = 1;
+
+	// stamps a task's start on construction & records it on destruction
+	class Scope final
+	{
+		WorkloadRecorder& m_recorder;
+		Clock::time_point m_enqueued;
+		Clock::time_point m_started;
+		std::uint32_t m_producer;
+	public:
+		Scope( WorkloadRecorder& recorder,
+			Clock::time_point enqueued,
+			std::uint32_t producer ) noexcept
+			:
+			m_recorder{recorder},
+			m_enqueued{enqueued},
+			m_started{Clock::now()},
+			m_producer{producer}
+		{
+
+		}
+		~Scope() noexcept
+		{
+			m_recorder.record( m_enqueued,
+				m_started,
+				Clock::now(),
+				m_producer );
+		}
+	};
+private:
+	std::ofstream m_file;
+	Clock::time_point m_origin;
+	std::mutex m_mu;
+	std::vector<WorkloadRecord> m_buffer;
+	std::mutex m_fileMu;
+public:
+	explicit WorkloadRecorder( const std::string& path );
+	~WorkloadRecorder() noexcept;
+	WorkloadRecorder( const WorkloadRecorder& ) = delete;
+	WorkloadRecorder& operator=( const WorkloadRecorder& ) = delete;
+
+	// drops the record if it cannot be stored
+	void record( Clock::time_point enqueued,
+		Clock::time_point started,
+		Clock::time_point finished,
+		std::uint32_t producer ) noexcept;
+	// writes out the records buffered so far
+	void flush();
+	//===================================================
+	//	\function	threadOrdinal
+	//	\brief  a small number identifying the calling thread, assigned on first use
+	//	\date	18/10/2026
+	static std::uint32_t threadOrdinal() noexcept;
+private:
+	void write( const std::vector<WorkloadRecord>& records );
+};
+
+//===================================================
+//	\function	loadWorkload
+//	\brief  reads a capture file, records sorted by enqueue time
+//	\date	18/10/2026
+std::vector<WorkloadRecord> loadWorkload( const std::string& path );
+
+
+struct ReplayReport
+{
+	std::size_t nTasks;
+	std::chrono::nanoseconds makespan;	// first enqueue until the last task finished
+	std::chrono::nanoseconds meanWait;
+	std::chrono::nanoseconds p99Wait;
+};
+
+//===================================================
+//	\function	replayWorkload
+//	\brief  recreates a captured workload on pool: one thread per recorded producer enqueues
+//				busy looping tasks of the recorded duration at the recorded times
+//			speed > 1 compresses the arrival times; task durations are kept
+//			returns the queue wait & makespan this pool configuration achieved
+//	\date	18/10/2026
+template<typename Pool>
+ReplayReport replayWorkload( Pool& pool,
+	const std::vector<WorkloadRecord>& records,
+	double speed = 1.0 )
+{
+	using Clock = WorkloadRecorder::Clock;
+
+	std::vector<std::uint32_t> producers;
+	for ( const WorkloadRecord& r : records )
+	{
+		producers.push_back( r.producer );
+	}
+	std::sort( producers.begin(), producers.end() );
+	producers.erase( std::unique( producers.begin(), producers.end() ),
+		producers.end() );
+
+	std::vector<std::int64_t> waits( records.size() );
+	std::vector<std::future<void>> futures( records.size() );
+	std::vector<std::thread> threads;
+	const Clock::time_point origin = Clock::now() + std::chrono::milliseconds{10};
+	for ( std::uint32_t producer : producers )
+	{
+		threads.emplace_back( [&, producer] ()
+		{
+			for ( std::size_t i = 0; i < records.size(); ++i )
+			{
+				const WorkloadRecord& r = records[i];
+				if ( r.producer != producer )
+				{
+					continue;
+				}
+				std::this_thread::sleep_until( origin
+					+ std::chrono::nanoseconds{static_cast<std::int64_t>( r.enqueueNs / speed )} );
+				futures[i] = pool.enqueue( [&waits, i, execNs = r.execNs, enqueued = Clock::now()] ()
+				{
+					const Clock::time_point started = Clock::now();
+					waits[i] = ( started - enqueued ).count();
+					const Clock::time_point until = started + std::chrono::nanoseconds{execNs};
+					while ( Clock::now() < until );
+				} );
+			}
+		} );
+	}
+	for ( auto& t : threads )
+	{
+		t.join();
+	}
+	for ( auto& fu : futures )
+	{
+		fu.get();
+	}
+	const Clock::time_point finished = Clock::now();
+
+	ReplayReport report{records.size(), finished - origin, {}, {}};
+	if ( !waits.empty() )
+	{
+		long double total = 0;
+		for ( std::int64_t w : waits )
+		{
+			total += w;
+		}
+		report.meanWait = std::chrono::nanoseconds{static_cast<std::int64_t>( total / waits.size() )};
+		auto p99 = waits.begin() + ( waits.size() - 1 ) * 99 / 100;
+		std::nth_element( waits.begin(), p99, waits.end() );
+		report.p99Wait = std::chrono::nanoseconds{*p99};
+	}
+	return report;
+}